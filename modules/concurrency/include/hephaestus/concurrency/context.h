@@ -5,7 +5,10 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <vector>
 
 #include <stdexec/execution.hpp>
 
@@ -19,9 +22,85 @@ namespace heph::concurrency {
 using TimerOptionsT = io_ring::TimerOptions;
 using ClockT = io_ring::TimerClock;
 
+/// Order in which a context runs the tasks which are ready.
+enum class ReadyQueuePolicy : std::uint8_t {
+  /// In the order they became ready.
+  FIFO,
+  /// Earliest deadline first. Tasks scheduled with a deadline, e.g. by periodic nodes, are ordered by
+  /// it, other tasks inherit the deadline of the task scheduling them or are due once ready. Under
+  /// overload the tasks with the latest deadlines are delayed first.
+  EARLIEST_DEADLINE_FIRST,
+};
+
+/// How a context waits for work once it ran out of ready tasks.
+enum class IdlePolicy : std::uint8_t {
+  /// Blocks on the ring right away, the thread gets woken up by the kernel.
+  BLOCK,
+  /// Spins on the ring for `BusyPollConfig::window` before blocking, trading CPU time for the latency
+  /// of waking up a blocked thread.
+  BUSY_POLL,
+  /// Spins for twice the recent average idle time, bounded by `BusyPollConfig::window`. Contexts
+  /// getting work in short intervals spin, the others block right away.
+  ADAPTIVE_BUSY_POLL,
+};
+
+struct BusyPollConfig {
+  static constexpr std::chrono::microseconds DEFAULT_WINDOW{ 50 };
+  IdlePolicy policy{ IdlePolicy::BLOCK };
+  std::chrono::microseconds window{ DEFAULT_WINDOW };
+};
+
+/// Accounts how a context waited for work, see `Context::idleStatistics`.
+struct IdleStatistics {
+  /// Number of busy polls.
+  std::uint64_t spins{ 0 };
+  /// Busy polls which found work before falling back to blocking.
+  std::uint64_t spin_hits{ 0 };
+  /// Total time spent busy polling.
+  std::chrono::nanoseconds spin_time{ 0 };
+  /// Delays between the due time of the earliest timed task and the context noticing it.
+  std::uint64_t timer_wakeups{ 0 };
+  std::chrono::nanoseconds wakeup_latency_total{ 0 };
+  std::chrono::nanoseconds wakeup_latency_max{ 0 };
+};
+
+/// Bounds the number of ready tasks run in a row before the context polls its ring again, keeping I/O
+/// completions from starving behind a long queue of tasks.
+struct TaskBudget {
+  static constexpr std::size_t DEFAULT_MAX_TASKS = 64;
+  std::size_t max_tasks{ DEFAULT_MAX_TASKS };
+  /// Ends a batch once it ran that long, unbounded if zero.
+  std::chrono::microseconds max_duration{ 0 };
+};
+
+/// Accounts the batches of tasks run between polls of the ring, see `Context::runStatistics`.
+struct RunStatistics {
+  /// Polls which ran at least one task.
+  std::uint64_t polls{ 0 };
+  /// Polls which found no ready task, e.g. woken up by I/O completions only.
+  std::uint64_t empty_polls{ 0 };
+  std::uint64_t tasks{ 0 };
+  std::uint64_t max_tasks_per_poll{ 0 };
+  /// Time the context has been running, up to the end of its last run.
+  std::chrono::nanoseconds duration{ 0 };
+
+  [[nodiscard]] auto tasksPerPoll() const -> double {
+    return polls == 0 ? 0.0 : static_cast<double>(tasks) / static_cast<double>(polls);
+  }
+
+  [[nodiscard]] auto pollsPerSecond() const -> double {
+    const auto seconds = std::chrono::duration<double>(duration).count();
+    return seconds == 0.0 ? 0.0 : static_cast<double>(polls) / seconds;
+  }
+};
+
 struct ContextConfig {
   io_ring::IoRingConfig io_ring_config;
   TimerOptionsT timer_options;
+  ReadyQueuePolicy ready_queue_policy{ ReadyQueuePolicy::FIFO };
+  /// Ignored with the simulated clock, which never blocks.
+  BusyPollConfig busy_poll;
+  TaskBudget task_budget;
 };
 
 class Context {
@@ -31,6 +110,9 @@ public:
   explicit Context(const ContextConfig& config)
     : ring_{ config.io_ring_config }
     , timer_{ ring_, config.timer_options }
+    , ready_queue_policy_(config.ready_queue_policy)
+    , busy_poll_(config.busy_poll)
+    , task_budget_(config.task_budget)
     , stop_callback_(ring_.getStopToken(), StopCallback{ this }) {
   }
 
@@ -64,6 +146,12 @@ public:
     return &ring_;
   }
 
+  /// \note Updated on the context, only access it when the context is not running.
+  [[nodiscard]] auto idleStatistics() const -> IdleStatistics;
+
+  /// \note Updated on the context, only access it when the context is not running.
+  [[nodiscard]] auto runStatistics() const -> RunStatistics;
+
 private:
   template <typename Receiver, typename Context>
   friend struct Task;
@@ -84,14 +172,41 @@ private:
   auto runTimedTasks() -> bool;
   auto runTasks() -> bool;
   auto runTasksSimulated() -> bool;
+  /// Spins on the ring according to the `BusyPollConfig`, returns true if work arrived meanwhile.
+  auto busyPoll() -> bool;
+  void updateAverageIdleTime(ClockT::base_clock::duration idle_time);
 
   void runTask(TaskBase* task);
 
+  void pushReady(TaskBase* task);
+  auto popReady() -> TaskBase*;
+  void eraseReady(TaskBase* task);
+  [[nodiscard]] auto readyEmpty() const -> bool;
+
+  struct DeadlineEntry {
+    TaskBase* task;
+    std::uint64_t sequence;  ///< Keeps tasks with the same deadline in FIFO order.
+  };
+
 private:
   io_ring::IoRing ring_;
   heph::containers::IntrusiveFifoQueue<TaskBase> tasks_;
   io_ring::Timer timer_;
+  ReadyQueuePolicy ready_queue_policy_;
+  BusyPollConfig busy_poll_;
+  IdleStatistics idle_statistics_;
+  TaskBudget task_budget_;
+  RunStatistics run_statistics_;
+  // Average time the context waited for work, drives IdlePolicy::ADAPTIVE_BUSY_POLL.
+  ClockT::base_clock::duration average_idle_time_{ 0 };
+  ClockT::base_clock::time_point idle_since_;
+  // Min heap of the ready tasks with ReadyQueuePolicy::EARLIEST_DEADLINE_FIRST.
+  std::vector<DeadlineEntry> deadline_tasks_;
+  std::uint64_t deadline_sequence_{ 0 };
+  ClockT::time_point running_deadline_;
   ClockT::base_clock::time_point start_time_;
+  // Set once `run` returned.
+  ClockT::base_clock::time_point end_time_;
   ClockT::base_clock::time_point last_progress_time_;
   stdexec::inplace_stop_callback<StopCallback> stop_callback_;
 };
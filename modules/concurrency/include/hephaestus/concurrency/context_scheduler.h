@@ -5,6 +5,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <optional>
 #include <tuple>
@@ -20,6 +21,7 @@
 #include "hephaestus/concurrency/basic_sender.h"
 #include "hephaestus/concurrency/io_ring/io_ring_operation_base.h"
 #include "hephaestus/concurrency/io_ring/timer.h"
+#include "hephaestus/concurrency/io_ring/timing_wheel.h"
 
 namespace heph::concurrency {
 class Context;
@@ -43,9 +45,12 @@ struct ContextScheduler {
     return scheduleAt(io_ring::TimerClock::now() + duration);
   }
 
+  /// Schedules at `time_point`. The optional `deadline` orders the task once ready if the context uses
+  /// `ReadyQueuePolicy::EARLIEST_DEADLINE_FIRST`.
   template <typename Clock, typename Duration, typename TagT = ContextScheduleAtT>
-  auto scheduleAt(std::chrono::time_point<Clock, Duration> time_point) {
-    return makeSenderExpression<TagT>(std::tuple{ self, time_point });
+  auto scheduleAt(std::chrono::time_point<Clock, Duration> time_point,
+                  io_ring::TimerClock::time_point deadline = {}) {
+    return makeSenderExpression<TagT>(std::tuple{ self, time_point, deadline });
   }
 
   [[nodiscard]] static constexpr auto query(stdexec::get_forward_progress_guarantee_t /*unused*/) noexcept {
@@ -108,8 +113,15 @@ struct TaskBase {
   virtual void setStopped() noexcept = 0;
 
   TaskDispatchOperation dispatch_operation{ this };
+  /// Only used with `ReadyQueuePolicy::EARLIEST_DEADLINE_FIRST`, assigned once ready if not set.
+  io_ring::TimerClock::time_point deadline;
   TaskBase* next{ nullptr };
   TaskBase* prev{ nullptr };
+  // Links of the timing wheel of the timer while waiting for the start time.
+  TaskBase* timer_next{ nullptr };
+  TaskBase* timer_prev{ nullptr };
+  std::uint64_t timer_tick{ 0 };
+  std::uint32_t timer_slot{ io_ring::TIMING_WHEEL_NO_SLOT };
 };
 
 template <typename Receiver, typename Context>
@@ -154,10 +166,11 @@ struct TimedTask : TaskBase {
 
   template <typename Clock, typename Duration>
   TimedTask(Context* context_input, std::chrono::time_point<Clock, Duration> start_time_input,
-            ReceiverT&& receiver_input)
+            io_ring::TimerClock::time_point deadline_input, ReceiverT&& receiver_input)
     : context(context_input)
     , start_time(std::chrono::time_point_cast<io_ring::TimerClock::duration>(start_time_input))
     , receiver(std::move(receiver_input)) {
+    deadline = deadline_input;
     // Avoid putting it the task in the timer when the deadline was already exceeded...
     if (start_time <= io_ring::TimerClock::now()) {
       timeout_started = true;
@@ -219,7 +232,8 @@ struct SenderExpressionImpl<ContextScheduleAtT> : DefaultSenderExpressionImpl {
                                                                            Receiver& receiver) {
     auto [_, data] = std::forward<Sender>(sender);
     auto* context = std::get<0>(data);
-    return TimedTask<std::decay_t<Receiver>, Context>{ context, std::get<1>(data), std::move(receiver) };
+    return TimedTask<std::decay_t<Receiver>, Context>{ context, std::get<1>(data), std::get<2>(data),
+                                                       std::move(receiver) };
   };
 
   static constexpr auto START = []<typename Receiver>(TimedTask<std::decay_t<Receiver>, Context>& task,
@@ -5,9 +5,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include <liburing.h>
 #include <liburing/io_uring.h>
@@ -18,42 +23,109 @@
 namespace heph::concurrency::io_ring {
 
 struct IoRingConfig {
-  static constexpr std::uint32_t DEFAULT_ENTRY_COUNT = 8;
+  static constexpr std::uint32_t DEFAULT_ENTRY_COUNT = 256;
+  static constexpr std::chrono::milliseconds DEFAULT_SQ_POLL_IDLE{ 1000 };
   std::uint32_t nentries{ DEFAULT_ENTRY_COUNT };
+  /// Additional `IORING_SETUP_*` flags passed to the kernel as is.
   std::uint32_t flags{ 0 };
+  /// Polls the submission queue from a kernel thread, submissions don't need a syscall as long as the
+  /// thread is busy (`IORING_SETUP_SQPOLL`).
+  bool sq_poll{ false };
+  /// CPU the polling thread is pinned to, not pinned if unset.
+  std::optional<std::uint32_t> sq_poll_cpu;
+  /// Time without submissions after which the polling thread goes to sleep.
+  std::chrono::milliseconds sq_poll_idle{ DEFAULT_SQ_POLL_IDLE };
+  /// Only the thread running the ring submits to it (`IORING_SETUP_SINGLE_ISSUER`). The ring gets
+  /// enabled once it runs, submissions before need to fit into the submission queue.
+  bool single_issuer{ false };
+  /// Defers the completion work of the kernel until the ring waits for completions, requires
+  /// `single_issuer` (`IORING_SETUP_DEFER_TASKRUN`).
+  bool defer_taskrun{ false };
+  /// Number of slots of the registered file table, see `IoRing::registerFile`.
+  std::uint32_t registered_files{ 0 };
+  /// Number of buffers registered with the ring, see `IoRing::fixedBuffer`.
+  std::uint32_t fixed_buffer_count{ 0 };
+  /// Size in bytes of each registered buffer.
+  std::size_t fixed_buffer_size{ 0 };
 };
 
 class IoRing {
 public:
   explicit IoRing(const IoRingConfig& config);
+  ~IoRing();
+
+  IoRing(const IoRing&) = delete;
+  auto operator=(const IoRing&) -> IoRing& = delete;
+  IoRing(IoRing&&) = delete;
+  auto operator=(IoRing&&) -> IoRing& = delete;
 
   auto stopRequested() -> bool;
   void requestStop();
   auto getStopToken() -> stdexec::inplace_stop_token;
 
+  /// Submits the operation to the ring. Called from another thread while the ring is running, the
+  /// operation is queued without blocking and picked up by the next iteration of the ring.
   void submit(IoRingOperationBase* operation);
   void runOnce(bool block = true);
   void run(
       const std::function<void()>& on_start = [] {},
       const std::function<bool()>& on_progress = [] { return false; });
 
+  /// True while `run` processes the ring.
   auto isRunning() -> bool;
   auto isCurrentRing() -> bool;
 
+  /// Submits the prepared operations and returns true if completions or operations queued by other
+  /// threads wait to be processed by `runOnce`. Never blocks, meant for busy polling the ring.
+  auto poll() -> bool;
+
+  /// Adds `fd` to the registered file table, sparing the kernel to look it up for every operation.
+  /// Returns the index to submit operations with together with `IOSQE_FIXED_FILE`, -1 if the table is
+  /// full or not configured. Can be called from any thread, also one running another ring.
+  auto registerFile(int fd) -> int;
+  /// Frees the slot of the table returned by `registerFile`.
+  void unregisterFile(int index) noexcept;
+
+  /// Returns the registered buffer with the given index, reads into it can use `io_uring_prep_read_fixed`.
+  auto fixedBuffer(std::size_t index) -> std::span<std::byte>;
+  /// Returns the index of the registered buffer containing `buffer`, -1 if there is none.
+  [[nodiscard]] auto findFixedBuffer(std::span<const std::byte> buffer) const -> int;
+
 private:
   auto getSqe() -> ::io_uring_sqe*;
   auto nextCompletion() -> io_uring_cqe*;
+  /// Posts `data` to the completion queue of `destination` using this ring, without waiting for the
+  /// message to be delivered. Needs to be called from the thread running this ring.
+  auto sendMessage(IoRing* destination, std::uint64_t data) -> bool;
+  void prepareSubmission(IoRingOperationBase* operation);
+  /// Queues an operation submitted from another thread, waking up the ring if the queue was empty.
+  void enqueueSubmission(IoRingOperationBase* operation);
+  /// Submits all operations queued by other threads, in the order they got queued per thread.
+  void drainSubmissions();
+  /// Arms the read of `wakeup_fd_` completing once other threads queued operations.
+  void armWakeup();
 
-  friend struct DispatchOperation;
   friend struct StopOperation;
 
 private:
   ::io_uring ring_{};
   IoRingConfig config_;
+  bool disabled_{ false };
+
+  std::mutex registered_files_mutex_;
+  std::vector<int> free_file_slots_;
+  std::vector<std::byte> fixed_buffers_;
   std::atomic<bool> running_{ false };
   stdexec::inplace_stop_source stop_source_;
 
   std::atomic<std::size_t> in_flight_{ 0 };
+
+  // Intrusive stack of the operations submitted from other threads, linked by
+  // `IoRingOperationBase::next_submission_`.
+  std::atomic<IoRingOperationBase*> submissions_{ nullptr };
+  int wakeup_fd_{ -1 };
+  std::uint64_t wakeup_value_{ 0 };
+  bool wakeup_armed_{ false };
   static thread_local IoRing* current_ring;
 };
 
@@ -8,6 +8,7 @@
 #include <liburing/io_uring.h>
 
 namespace heph::concurrency::io_ring {
+class IoRing;
 
 class IoRingOperationBase {
 public:
@@ -17,5 +18,10 @@ public:
     ::io_uring_prep_nop(sqe);
   }
   virtual void handleCompletion(::io_uring_cqe* cqe) = 0;
+
+private:
+  friend class IoRing;
+  /// Link of the queue of operations submitted to a ring from other threads.
+  IoRingOperationBase* next_submission_{ nullptr };
 };
 }  // namespace heph::concurrency::io_ring
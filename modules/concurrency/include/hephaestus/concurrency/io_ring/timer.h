@@ -7,7 +7,6 @@
 #include <chrono>
 #include <cstdint>
 #include <optional>
-#include <vector>
 
 #include <liburing.h>  // NOLINT(misc-include-cleaner)
 #include <liburing/compat.h>
@@ -15,6 +14,7 @@
 
 #include "hephaestus/concurrency/io_ring/io_ring.h"
 #include "hephaestus/concurrency/io_ring/stoppable_io_ring_operation.h"
+#include "hephaestus/concurrency/io_ring/timing_wheel.h"
 
 namespace heph::concurrency {
 struct TaskBase;
@@ -25,6 +25,9 @@ enum class ClockMode : std::uint8_t { WALLCLOCK, SIMULATED };
 
 struct TimerOptions {
   ClockMode clock_mode{ ClockMode::WALLCLOCK };
+  /// Granularity of the timing wheel, see `Timer`. Start times are rounded up to it, coarser
+  /// resolutions batch tasks into fewer wakeups of the ring.
+  std::chrono::microseconds resolution{ 1 };
 };
 
 class Timer;
@@ -46,22 +49,23 @@ struct TimerClock {
   static Timer* timer;
 };
 
-struct TimerEntry {
-  TaskBase* task{ nullptr };
-  TimerClock::time_point start_time;
-
-  friend auto operator<=>(const TimerEntry& lhs, const TimerEntry& rhs) {
-    return lhs.start_time <=> rhs.start_time;
-  }
+/// Delays between the due time of the earliest timed task and the timer noticing it.
+struct TimerWakeupStatistics {
+  std::uint64_t wakeups{ 0 };
+  TimerClock::duration total_latency{ 0 };
+  TimerClock::duration max_latency{ 0 };
 };
 
+/// Starts tasks at their start time. Pending tasks are kept in a `TimingWheel`, only the earliest start
+/// time is armed as a timeout on the ring.
+/// Wakeups of the statistics only count timeouts which started a task.
 class Timer {
 public:
   explicit Timer(IoRing& ring, TimerOptions options);
   ~Timer() noexcept;
 
   auto empty() const -> bool {
-    return tasks_.empty();
+    return wheel_.empty();
   }
 
   void requestStop();
@@ -90,6 +94,10 @@ public:
     return clock_mode_;
   }
 
+  [[nodiscard]] auto wakeupStatistics() const -> const TimerWakeupStatistics& {
+    return wakeup_statistics_;
+  }
+
 private:
   struct Operation {
     void prepare(::io_uring_sqe* sqe) const;
@@ -109,7 +117,12 @@ private:
   };
 
   void update(TimerClock::time_point start_time);
-  auto next(bool advance = false) -> TaskBase*;
+  /// Arms the timeout of the ring for `tick`, unless an earlier one is armed.
+  void arm(std::uint64_t tick);
+  /// Advances the wheel to `now`, starting the tasks due until then.
+  void startDue(TimerClock::time_point now);
+  [[nodiscard]] auto tickOf(TimerClock::time_point time) const -> std::uint64_t;
+  [[nodiscard]] auto timeOf(std::uint64_t tick) const -> TimerClock::time_point;
 
   friend struct TimerClock;
 
@@ -118,10 +131,13 @@ private:
   __kernel_timespec next_timeout_{};
   std::optional<StoppableIoRingOperation<Operation>> timer_operation_;
   std::optional<StoppableIoRingOperation<UpdateOperation>> update_timer_operation_;
-  std::vector<TimerEntry> tasks_;
 
   TimerClock::time_point start_;
   TimerClock::time_point last_tick_;
   ClockMode clock_mode_;
+  TimerClock::duration resolution_;
+  TimingWheel<TaskBase> wheel_;
+  std::uint64_t armed_tick_{ TimingWheel<TaskBase>::NO_TICK };
+  TimerWakeupStatistics wakeup_statistics_;
 };
 }  // namespace heph::concurrency::io_ring
@@ -0,0 +1,265 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace heph::concurrency::io_ring {
+
+/// Value of `timer_slot` of elements not in a timing wheel.
+inline constexpr std::uint32_t TIMING_WHEEL_NO_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+template <typename T>
+concept TimingWheelElement = requires(T t) {
+  { t.timer_next } -> std::same_as<T*&>;
+  { t.timer_prev } -> std::same_as<T*&>;
+  { t.timer_tick } -> std::same_as<std::uint64_t&>;
+  { t.timer_slot } -> std::same_as<std::uint32_t&>;
+};
+
+/// Hierarchical timing wheel of intrusively linked elements expiring at a tick. Inserting and erasing
+/// are O(1), advancing costs O(1) per processed slot plus the elements cascading from coarser levels
+/// into finer ones. The first level covers 64 ticks, each further level 64 times the previous one, and
+/// elements beyond the last level wait in an overflow list.
+template <typename T>
+class TimingWheel {
+public:
+  static constexpr std::uint64_t NO_TICK = std::numeric_limits<std::uint64_t>::max();
+
+  explicit TimingWheel(std::uint64_t current_tick = 0) : current_(current_tick) {
+  }
+
+  [[nodiscard]] auto empty() const -> bool {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    return size_;
+  }
+
+  /// Tick up to which the wheel got advanced.
+  [[nodiscard]] auto currentTick() const -> std::uint64_t {
+    return current_;
+  }
+
+  /// Adds `t` expiring at `tick`, ticks already passed expire with the next advance.
+  void insert(T* t, std::uint64_t tick)
+    requires TimingWheelElement<T>
+  {
+    t->timer_tick = std::max(tick, current_);
+    link(t, slotFor(t->timer_tick));
+    ++size_;
+  }
+
+  /// Removes `t`, returns false if it is not in the wheel.
+  auto erase(T* t) -> bool
+    requires TimingWheelElement<T>
+  {
+    if (t->timer_slot == TIMING_WHEEL_NO_SLOT) {
+      return false;
+    }
+    unlink(t);
+    --size_;
+    return true;
+  }
+
+  /// Tick of the next slot to process, either the expiry of its elements or the point at which a slot
+  /// of a coarser level cascades into the finer ones. `NO_TICK` if the wheel is empty.
+  [[nodiscard]] auto nextTick() const -> std::uint64_t {
+    const auto slot = firstSlot();
+    if (slot == TIMING_WHEEL_NO_SLOT) {
+      return NO_TICK;
+    }
+    if (slot == OVERFLOW_SLOT) {
+      return blockStart(current_, LEVELS) + (std::uint64_t{ 1 } << (BITS_PER_LEVEL * LEVELS));
+    }
+    const std::size_t level = slot / SLOTS;
+    return blockStart(current_, level + 1) + (std::uint64_t{ slot % SLOTS } << (BITS_PER_LEVEL * level));
+  }
+
+  /// Earliest tick an element expires at, `NO_TICK` if the wheel is empty. Unlike `nextTick` it skips
+  /// the points at which slots cascade, at the cost of scanning the first occupied slot if it belongs
+  /// to a coarser level.
+  [[nodiscard]] auto nextExpiry() const -> std::uint64_t {
+    const auto slot = firstSlot();
+    if (slot == TIMING_WHEEL_NO_SLOT) {
+      return NO_TICK;
+    }
+    // Elements of a slot of the first level all expire at the same tick.
+    if (slot < SLOTS) {
+      return slots_[slot]->timer_tick;
+    }
+    auto tick = NO_TICK;
+    for (const T* t = slots_[slot]; t != nullptr; t = t->timer_next) {
+      tick = std::min(tick, t->timer_tick);
+    }
+    return tick;
+  }
+
+  /// Advances the wheel to `tick`, calling `on_expired(T*)` for all elements expiring until then. The
+  /// callbacks run once the wheel is consistent again, they may insert and erase other elements.
+  template <typename F>
+  void advance(std::uint64_t tick, F&& on_expired)
+    requires TimingWheelElement<T>
+  {
+    T* expired = nullptr;
+    for (auto next = nextTick(); next <= tick; next = nextTick()) {
+      current_ = next;
+      if (blockStart(next, LEVELS) == next) {
+        cascade(OVERFLOW_SLOT);
+      }
+      for (std::size_t level = LEVELS - 1; level != 0; --level) {
+        if (blockStart(next, level) == next) {
+          cascade(static_cast<std::uint32_t>((level * SLOTS) + digitOf(next, level)));
+        }
+      }
+      expired = detach(static_cast<std::uint32_t>(digitOf(next, 0)), expired);
+    }
+    current_ = std::max(current_, tick);
+    forEach(expired, std::forward<F>(on_expired));
+  }
+
+  /// Removes all elements, calling `f(T*)` for each of them.
+  template <typename F>
+  void clear(F&& f)
+    requires TimingWheelElement<T>
+  {
+    T* removed = nullptr;
+    for (std::uint32_t slot = 0; slot != slots_.size(); ++slot) {
+      removed = detach(slot, removed);
+    }
+    forEach(removed, std::forward<F>(f));
+  }
+
+private:
+  static constexpr std::size_t BITS_PER_LEVEL = 6;
+  static constexpr std::size_t SLOTS = std::size_t{ 1 } << BITS_PER_LEVEL;
+  static constexpr std::size_t LEVELS = 6;
+  static constexpr auto OVERFLOW_SLOT = static_cast<std::uint32_t>(LEVELS * SLOTS);
+
+  static constexpr auto digitOf(std::uint64_t tick, std::size_t level) -> std::uint64_t {
+    return (tick >> (BITS_PER_LEVEL * level)) & (SLOTS - 1);
+  }
+
+  /// First tick of the block of `tick` covered by one slot of `level`.
+  static constexpr auto blockStart(std::uint64_t tick, std::size_t level) -> std::uint64_t {
+    return (tick >> (BITS_PER_LEVEL * level)) << (BITS_PER_LEVEL * level);
+  }
+
+  /// Occupied slot holding the earliest elements, `TIMING_WHEEL_NO_SLOT` if the wheel is empty.
+  [[nodiscard]] auto firstSlot() const -> std::uint32_t {
+    if (size_ == 0) {
+      return TIMING_WHEEL_NO_SLOT;
+    }
+    // Slots of a level all precede the slots of the coarser levels, the first occupied one wins.
+    for (std::size_t level = 0; level != LEVELS; ++level) {
+      const auto digit = digitOf(current_, level);
+      // Coarser levels never hold the slot of the current tick, it got cascaded when reached.
+      const auto first = level == 0 ? digit : digit + 1;
+      if (first == SLOTS) {
+        continue;
+      }
+      const auto candidates = occupied_[level] & (~std::uint64_t{ 0 } << first);
+      if (candidates == 0) {
+        continue;
+      }
+      const auto index = static_cast<std::size_t>(std::countr_zero(candidates));
+      return static_cast<std::uint32_t>((level * SLOTS) + index);
+    }
+    return OVERFLOW_SLOT;
+  }
+
+  /// Finest level whose slots tell `tick` apart from the current tick.
+  [[nodiscard]] auto slotFor(std::uint64_t tick) const -> std::uint32_t {
+    for (std::size_t level = 0; level != LEVELS; ++level) {
+      if (blockStart(tick, level + 1) == blockStart(current_, level + 1)) {
+        return static_cast<std::uint32_t>((level * SLOTS) + digitOf(tick, level));
+      }
+    }
+    return OVERFLOW_SLOT;
+  }
+
+  void link(T* t, std::uint32_t slot) {
+    t->timer_slot = slot;
+    t->timer_prev = nullptr;
+    t->timer_next = slots_[slot];
+    if (t->timer_next != nullptr) {
+      t->timer_next->timer_prev = t;
+    }
+    slots_[slot] = t;
+    if (slot != OVERFLOW_SLOT) {
+      occupied_[slot / SLOTS] |= std::uint64_t{ 1 } << (slot % SLOTS);
+    }
+  }
+
+  void unlink(T* t) {
+    const auto slot = t->timer_slot;
+    if (t->timer_prev != nullptr) {
+      t->timer_prev->timer_next = t->timer_next;
+    } else {
+      slots_[slot] = t->timer_next;
+    }
+    if (t->timer_next != nullptr) {
+      t->timer_next->timer_prev = t->timer_prev;
+    }
+    if (slots_[slot] == nullptr && slot != OVERFLOW_SLOT) {
+      occupied_[slot / SLOTS] &= ~(std::uint64_t{ 1 } << (slot % SLOTS));
+    }
+    t->timer_next = nullptr;
+    t->timer_prev = nullptr;
+    t->timer_slot = TIMING_WHEEL_NO_SLOT;
+  }
+
+  /// Moves the elements of `slot` to the front of the list `list`, linked by `timer_next`.
+  auto detach(std::uint32_t slot, T* list) -> T* {
+    while (slots_[slot] != nullptr) {
+      auto* t = slots_[slot];
+      unlink(t);
+      --size_;
+      t->timer_next = list;
+      list = t;
+    }
+    return list;
+  }
+
+  /// Redistributes the elements of `slot` relative to the current tick.
+  void cascade(std::uint32_t slot) {
+    // Elements of the overflow list may end up in it again, detach them all first.
+    auto* list = slots_[slot];
+    slots_[slot] = nullptr;
+    if (slot != OVERFLOW_SLOT) {
+      occupied_[slot / SLOTS] &= ~(std::uint64_t{ 1 } << (slot % SLOTS));
+    }
+    while (list != nullptr) {
+      auto* t = list;
+      list = t->timer_next;
+      link(t, slotFor(t->timer_tick));
+    }
+  }
+
+  template <typename F>
+  static void forEach(T* list, F&& f) {
+    while (list != nullptr) {
+      auto* t = list;
+      list = t->timer_next;
+      t->timer_next = nullptr;
+      f(t);
+    }
+  }
+
+private:
+  std::array<T*, (LEVELS * SLOTS) + 1> slots_{};
+  std::array<std::uint64_t, LEVELS> occupied_{};
+  std::uint64_t current_;
+  std::size_t size_{ 0 };
+};
+
+}  // namespace heph::concurrency::io_ring
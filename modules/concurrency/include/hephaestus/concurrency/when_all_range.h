@@ -132,7 +132,12 @@ struct Operation {
   using InnerOperationT = stdexec::connect_result_t<SenderT, InnerReceiverT>;
 
   void start() noexcept {
-    state.count.store(N, std::memory_order_release);
+    const auto size = std::ranges::size(range);
+    if (size == 0) {
+      stdexec::set_value(std::move(state.receiver));
+      return;
+    }
+    state.count.store(size, std::memory_order_release);
     state.on_stop.emplace(stdexec::get_stop_token(stdexec::get_env(state.receiver)),
                           WhenAllStopCallback{ &state.stop_source });
     for (auto& sender : range) {
@@ -166,18 +171,18 @@ struct WhenAllRangeSender {
 };
 }  // namespace internal
 
-/// Wait on a range of senders with a fixed size.
+/// Wait on a range of senders with a bounded size.
 ///
-/// \tparam N Number of elements in the range
+/// \tparam N Maximum number of elements in the range
 /// \param range the range of senders to wait on. Takes ownership of the range
 ///
 /// \note Currently only senders completing with void are supported
 ///
-/// This function operates on a fixed size range. The
+/// The operation states of all senders are stored inline, an empty range completes right away.
 template <std::size_t N, SenderRange Range, typename RangeT = std::decay_t<Range>>
   requires(N > 0)
 [[nodiscard]] auto whenAllRange(Range&& range) {
-  HEPH_PANIC_IF(N != std::ranges::size(range), "Size mismatch");
+  HEPH_PANIC_IF(std::ranges::size(range) > N, "Size mismatch");
   return internal::WhenAllRangeSender<N, RangeT>{ std::forward<Range>(range) };
 }
 }  // namespace heph::concurrency
@@ -4,7 +4,9 @@
 
 #include "hephaestus/concurrency/context.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 
 #include "hephaestus/concurrency/context_scheduler.h"
@@ -14,13 +16,22 @@ namespace heph::concurrency {
 void Context::run(const std::function<void()>& on_start) {
   std::function<bool()> on_progress;
   if (timer_.clockMode() == io_ring::ClockMode::WALLCLOCK) {
-    on_progress = [this] { return runTasks(); };
+    on_progress = [this] {
+      if (idle_since_ != ClockT::base_clock::time_point{}) {
+        // Woken up after blocking on the ring.
+        updateAverageIdleTime(ClockT::base_clock::now() - idle_since_);
+        idle_since_ = {};
+      }
+      return runTasks() || busyPoll();
+    };
   } else {
     on_progress = [this] { return runTasksSimulated(); };
   }
   start_time_ = ClockT::base_clock::now();
+  end_time_ = {};
   last_progress_time_ = ClockT::base_clock::now();
   ring_.run(on_start, on_progress);
+  end_time_ = ClockT::base_clock::now();
 }
 
 void Context::enqueue(TaskBase* task) {
@@ -29,7 +40,7 @@ void Context::enqueue(TaskBase* task) {
     return;
   }
   if (!ring_.isRunning() || ring_.isCurrentRing()) {
-    tasks_.enqueue(task);
+    pushReady(task);
     return;
   }
   ring_.submit(&task->dispatch_operation);
@@ -42,7 +53,7 @@ void Context::enqueueAt(TaskBase* task, ClockT::time_point start_time) {
   }
   if (!ring_.isRunning() || ring_.isCurrentRing()) {
     if (start_time <= timer_.now()) {
-      tasks_.enqueue(task);
+      pushReady(task);
       return;
     }
     timer_.startAt(task, start_time);
@@ -52,19 +63,31 @@ void Context::enqueueAt(TaskBase* task, ClockT::time_point start_time) {
 }
 
 void Context::dequeueTimer(TaskBase* task) {
-  (void)tasks_.erase(task);
+  eraseReady(task);
   timer_.dequeue(task);
 }
 
 auto Context::runTasks() -> bool {
-  if (tasks_.empty()) {
+  if (readyEmpty()) {
+    ++run_statistics_.empty_polls;
     return false;
   }
+  ++run_statistics_.polls;
 
-  auto* task = tasks_.dequeue();
-  runTask(task);
+  // Run a batch of tasks before going back to the ring, which costs a syscall per poll.
+  const bool timed = task_budget_.max_duration != std::chrono::microseconds{ 0 };
+  const auto batch_end = timed ? ClockT::base_clock::now() + task_budget_.max_duration :
+                                 ClockT::base_clock::time_point{};
+  std::uint64_t tasks = 0;
+  do {
+    runTask(popReady());
+    ++tasks;
+  } while (!readyEmpty() && tasks < task_budget_.max_tasks &&
+           (!timed || ClockT::base_clock::now() < batch_end));
 
-  return !tasks_.empty();
+  run_statistics_.tasks += tasks;
+  run_statistics_.max_tasks_per_poll = std::max(run_statistics_.max_tasks_per_poll, tasks);
+  return !readyEmpty();
 }
 
 auto Context::runTasksSimulated() -> bool {
@@ -72,21 +95,133 @@ auto Context::runTasksSimulated() -> bool {
   timer_.advanceSimulation(now - last_progress_time_);
   last_progress_time_ = now;
 
-  timer_.tickSimulated(tasks_.empty());
+  timer_.tickSimulated(readyEmpty());
 
   runTasks();
 
-  if (tasks_.empty() && timer_.empty() && stopRequested()) {
+  if (readyEmpty() && timer_.empty() && stopRequested()) {
     return false;
   }
   return true;
 }
 
+auto Context::busyPoll() -> bool {
+  if (busy_poll_.policy == IdlePolicy::BLOCK) {
+    return false;
+  }
+  ClockT::base_clock::duration window{ busy_poll_.window };
+  if (busy_poll_.policy == IdlePolicy::ADAPTIVE_BUSY_POLL) {
+    // Waiting longer than the window on average, spinning would mostly be in vain.
+    window = average_idle_time_ > window ? ClockT::base_clock::duration{ 0 } :
+                                           std::min(window, 2 * average_idle_time_);
+  }
+
+  const auto start = ClockT::base_clock::now();
+  auto now = start;
+  bool found_work = false;
+  while (now - start < window && !ring_.stopRequested()) {
+    if (ring_.poll()) {
+      found_work = true;
+      break;
+    }
+    now = ClockT::base_clock::now();
+  }
+
+  if (window != ClockT::base_clock::duration{ 0 }) {
+    ++idle_statistics_.spins;
+    idle_statistics_.spin_time += now - start;
+  }
+  if (found_work) {
+    ++idle_statistics_.spin_hits;
+    updateAverageIdleTime(now - start);
+    return true;
+  }
+  idle_since_ = start;
+  return false;
+}
+
+void Context::updateAverageIdleTime(ClockT::base_clock::duration idle_time) {
+  // Exponential moving average, recent idle times weigh the most.
+  static constexpr int SMOOTHING = 8;
+  average_idle_time_ += (idle_time - average_idle_time_) / SMOOTHING;
+}
+
+auto Context::runStatistics() const -> RunStatistics {
+  auto statistics = run_statistics_;
+  if (start_time_ != ClockT::base_clock::time_point{}) {
+    const auto end_time =
+        end_time_ != ClockT::base_clock::time_point{} ? end_time_ : ClockT::base_clock::now();
+    statistics.duration = end_time - start_time_;
+  }
+  return statistics;
+}
+
+auto Context::idleStatistics() const -> IdleStatistics {
+  auto statistics = idle_statistics_;
+  const auto& timer_statistics = timer_.wakeupStatistics();
+  statistics.timer_wakeups = timer_statistics.wakeups;
+  statistics.wakeup_latency_total = timer_statistics.total_latency;
+  statistics.wakeup_latency_max = timer_statistics.max_latency;
+  return statistics;
+}
+
 void Context::runTask(TaskBase* task) {
   if (ring_.stopRequested()) {
     task->setStopped();
   } else {
+    running_deadline_ = task->deadline;
     task->setValue();
+    running_deadline_ = {};
   }
 }
+
+namespace {
+// Orders the heap of deadline entries by the earliest deadline, the oldest entry first.
+constexpr auto LATER_DEADLINE = [](const auto& lhs, const auto& rhs) {
+  if (lhs.task->deadline != rhs.task->deadline) {
+    return lhs.task->deadline > rhs.task->deadline;
+  }
+  return lhs.sequence > rhs.sequence;
+};
+}  // namespace
+
+void Context::pushReady(TaskBase* task) {
+  if (ready_queue_policy_ == ReadyQueuePolicy::FIFO) {
+    tasks_.enqueue(task);
+    return;
+  }
+  if (task->deadline == ClockT::time_point{}) {
+    task->deadline = running_deadline_ != ClockT::time_point{} ? running_deadline_ : ClockT::now();
+  }
+  deadline_tasks_.push_back({ .task = task, .sequence = deadline_sequence_++ });
+  std::ranges::push_heap(deadline_tasks_, LATER_DEADLINE);
+}
+
+auto Context::popReady() -> TaskBase* {
+  if (ready_queue_policy_ == ReadyQueuePolicy::FIFO) {
+    return tasks_.dequeue();
+  }
+  std::ranges::pop_heap(deadline_tasks_, LATER_DEADLINE);
+  auto* task = deadline_tasks_.back().task;
+  deadline_tasks_.pop_back();
+  return task;
+}
+
+void Context::eraseReady(TaskBase* task) {
+  if (ready_queue_policy_ == ReadyQueuePolicy::FIFO) {
+    (void)tasks_.erase(task);
+    return;
+  }
+  auto it = std::ranges::find_if(deadline_tasks_,
+                                 [task](const DeadlineEntry& entry) { return entry.task == task; });
+  if (it == deadline_tasks_.end()) {
+    return;
+  }
+  deadline_tasks_.erase(it);
+  std::ranges::make_heap(deadline_tasks_, LATER_DEADLINE);
+}
+
+auto Context::readyEmpty() const -> bool {
+  return ready_queue_policy_ == ReadyQueuePolicy::FIFO ? tasks_.empty() : deadline_tasks_.empty();
+}
 }  // namespace heph::concurrency
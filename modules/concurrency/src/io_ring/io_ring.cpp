@@ -5,12 +5,19 @@
 #include <cerrno>
 #include <cstdint>
 #include <cstring>
+#include <cstddef>
 #include <functional>
+#include <mutex>
+#include <span>
 #include <system_error>
+#include <vector>
 
 #include <liburing.h>  // NOLINT(misc-include-cleaner)
 #include <liburing/io_uring.h>
 #include <stdexec/stop_token.hpp>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
 #include "hephaestus/concurrency/io_ring/io_ring_operation_base.h"
 #include "hephaestus/error_handling/panic.h"
@@ -18,63 +25,105 @@
 namespace heph::concurrency::io_ring {
 thread_local IoRing* IoRing::current_ring = nullptr;
 
-struct DispatchOperation : IoRingOperationBase {
-  static auto ring() -> IoRing& {
-    static thread_local IoRing r{ { .nentries = IoRingConfig::DEFAULT_ENTRY_COUNT, .flags = 0 } };
-    return r;
+namespace {
+// user_data of messages exchanged between rings which are not backed by an operation on the
+// sending side. Operations are at least pointer aligned, the lower bits are therefore free to tag
+// the operations which need to be submitted once they arrive at the destination ring.
+constexpr std::uint64_t SUBMIT_MESSAGE_TAG = 0b01;
+constexpr std::uint64_t STOP_MESSAGE = 0b10;
+// user_data of the read of the eventfd other threads signal once they queued operations.
+constexpr std::uint64_t WAKEUP_MESSAGE = 0b11;
+
+auto toUserData(IoRingOperationBase* operation) -> std::uint64_t {
+  std::uint64_t data{};
+  static_assert(sizeof(data) == sizeof(void*));
+  std::memcpy(&data, static_cast<void*>(&operation), sizeof(data));
+  return data;
+}
+
+auto fromUserData(std::uint64_t data) -> IoRingOperationBase* {
+  IoRingOperationBase* operation{ nullptr };
+  std::memcpy(static_cast<void*>(&operation), &data, sizeof(data));
+  return operation;
+}
+
+// Points `slot` of the registered file table at `fd`, -1 clears it. Goes through the file descriptor of
+// the ring: once `run` registered it, `io_uring_register_files_update` uses the registered index instead,
+// which only refers to this ring on the thread running it.
+auto updateRegisteredFile(::io_uring& ring, int slot, int fd) -> int {
+  ::io_uring_files_update update{};
+  update.offset = static_cast<std::uint32_t>(slot);
+  update.fds = reinterpret_cast<std::uintptr_t>(&fd);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  return ::io_uring_register(static_cast<unsigned>(ring.ring_fd), IORING_REGISTER_FILES_UPDATE, &update, 1);
+}
+}  // namespace
+
+IoRing::IoRing(const IoRingConfig& config) : config_(config) {
+  ::io_uring_params params{};
+  params.flags = config_.flags;
+  if (config_.sq_poll) {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = static_cast<std::uint32_t>(config_.sq_poll_idle.count());
+    if (config_.sq_poll_cpu.has_value()) {
+      params.flags |= IORING_SETUP_SQ_AFF;
+      params.sq_thread_cpu = *config_.sq_poll_cpu;
+    }
+  }
+  if (config_.defer_taskrun && !config_.single_issuer) {
+    panic("IoRingConfig::defer_taskrun requires single_issuer");
   }
+  if (config_.single_issuer) {
+    // The issuer is the thread enabling the ring, which is the one running it rather than the one
+    // creating it.
+    params.flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED;
+    disabled_ = true;
+  }
+  if (config_.defer_taskrun) {
+    params.flags |= IORING_SETUP_DEFER_TASKRUN;
+  }
+  int res = ::io_uring_queue_init_params(config_.nentries, &ring_, &params);
 
-  void prepare(::io_uring_sqe* sqe) final {
-    auto* ptr{ this };
-    std::uint64_t data{};
-    static_assert(sizeof(data) == sizeof(void*));
-    std::memcpy(&data, static_cast<void*>(&ptr), sizeof(data));
-    ::io_uring_prep_msg_ring(sqe, destination->ring_.ring_fd, 0, data, 0);
+  if (res < 0) {
+    panic("::io_uring_queue_init failed: {}", std::error_code(-res, std::system_category()).message());
   }
 
-  void handleCompletion(io_uring_cqe* cqe) final {
-    if (destination->isCurrentRing()) {
-      // Resubmit operation to the ring.
-      // Some operations don't need an extra prepare and simply act as a trigger
-      // so we can omit the submit phase entirely
-      destination->submit(operation);
-      submit_done.store(true, std::memory_order_release);
-      submit_done.notify_all();
-      return;
+  if (config_.registered_files > 0) {
+    res = ::io_uring_register_files_sparse(&ring_, config_.registered_files);
+    if (res < 0) {
+      panic("::io_uring_register_files_sparse failed: {}",
+            std::error_code(-res, std::system_category()).message());
     }
-    if (cqe->res < 0) {
-      panic("dispatch failed: {}", std::error_code(-cqe->res, std::system_category()).message());
+    for (auto slot = static_cast<int>(config_.registered_files); slot != 0; --slot) {
+      free_file_slots_.push_back(slot - 1);
     }
-
-    dispatch_done.store(true, std::memory_order_release);
   }
 
-  void run() {
-    destination->in_flight_.fetch_add(1, std::memory_order_release);
-    ring().submit(this);
-    while (!dispatch_done.load(std::memory_order_acquire)) {
-      ring().runOnce();
+  if (config_.fixed_buffer_count > 0) {
+    fixed_buffers_.resize(config_.fixed_buffer_count * config_.fixed_buffer_size);
+    std::vector<::iovec> buffers;
+    buffers.reserve(config_.fixed_buffer_count);
+    for (std::size_t i = 0; i != config_.fixed_buffer_count; ++i) {
+      auto buffer = fixedBuffer(i);
+      buffers.push_back({ .iov_base = buffer.data(), .iov_len = buffer.size() });
     }
-
-    while (!submit_done.load(std::memory_order_acquire)) {
-      submit_done.wait(false, std::memory_order_acquire);
+    res = ::io_uring_register_buffers(&ring_, buffers.data(), config_.fixed_buffer_count);
+    if (res < 0) {
+      panic("::io_uring_register_buffers failed: {}",
+            std::error_code(-res, std::system_category()).message());
     }
   }
 
-  IoRing* destination{ nullptr };
-  IoRingOperationBase* operation{ nullptr };
-  std::atomic<bool> dispatch_done{ false };
-  std::atomic<bool> submit_done{ false };
-};
-
-IoRing::IoRing(const IoRingConfig& config) : config_(config) {
-  const int res = ::io_uring_queue_init(config_.nentries, &ring_, config_.flags);
-
-  if (res < 0) {
-    panic("::io_uring_queue_init failed: {}", std::error_code(-res, std::system_category()).message());
+  wakeup_fd_ = ::eventfd(0, EFD_CLOEXEC);
+  if (wakeup_fd_ < 0) {
+    panic("::eventfd failed: {}", std::error_code(errno, std::system_category()).message());
   }
 }
 
+IoRing::~IoRing() {
+  ::io_uring_queue_exit(&ring_);
+  ::close(wakeup_fd_);
+}
+
 struct StopOperation : IoRingOperationBase {
   void handleCompletion(::io_uring_cqe* /*cqe*/) final {
     self->requestStop();
@@ -98,12 +147,12 @@ auto IoRing::stopRequested() -> bool {
 
 void IoRing::requestStop() {
   if (!isCurrentRing() && isRunning()) {
+    if (current_ring != nullptr && current_ring->sendMessage(this, STOP_MESSAGE)) {
+      return;
+    }
     StopOperation stop_operation;
     stop_operation.self = this;
-    DispatchOperation dispatch;
-    dispatch.destination = this;
-    dispatch.operation = &stop_operation;
-    dispatch.run();
+    enqueueSubmission(&stop_operation);
     stop_operation.wait();
     return;
   }
@@ -114,6 +163,7 @@ auto IoRing::getStopToken() -> stdexec::inplace_stop_token {
 }
 
 void IoRing::runOnce(bool block) {
+  drainSubmissions();
   int res{ 0 };
   if (block) {
     res = ::io_uring_submit_and_wait(&ring_, 1);
@@ -125,8 +175,31 @@ void IoRing::runOnce(bool block) {
   }
 
   for (auto* cqe = nextCompletion(); cqe != nullptr; cqe = nextCompletion()) {
-    auto* operation{ static_cast<IoRingOperationBase*>(io_uring_cqe_get_data(cqe)) };
-    operation->handleCompletion(cqe);
+    const std::uint64_t data = cqe->user_data;
+    if (data == 0) {
+      // Completion of a message we sent to another ring
+      if (cqe->res < 0) {
+        panic("sending message to ring failed: {}",
+              std::error_code(-cqe->res, std::system_category()).message());
+      }
+    } else if (data == STOP_MESSAGE) {
+      stop_source_.request_stop();
+    } else if (data == WAKEUP_MESSAGE) {
+      if (cqe->res < 0 && cqe->res != -EINTR) {
+        panic("reading wakeup eventfd failed: {}",
+              std::error_code(-cqe->res, std::system_category()).message());
+      }
+      // The wakeup read is not accounted as in flight, it would otherwise keep the ring running.
+      io_uring_cqe_seen(&ring_, cqe);
+      wakeup_armed_ = false;
+      drainSubmissions();
+      armWakeup();
+      continue;
+    } else if ((data & SUBMIT_MESSAGE_TAG) != 0) {
+      submit(fromUserData(data & ~SUBMIT_MESSAGE_TAG));
+    } else {
+      fromUserData(data)->handleCompletion(cqe);
+    }
     io_uring_cqe_seen(&ring_, cqe);
     if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
       in_flight_.fetch_sub(1, std::memory_order_release);
@@ -141,12 +214,21 @@ void IoRing::run(const std::function<void()>& on_started, const std::function<bo
 
   int res = 0;
 
+  if (disabled_) {
+    res = ::io_uring_enable_rings(&ring_);
+    if (res < 0) {
+      panic("::io_uring_enable_rings failed: {}", std::error_code(-res, std::system_category()).message());
+    }
+    disabled_ = false;
+  }
+
   res = ::io_uring_register_ring_fd(&ring_);
 
   if (res < 0) {
     panic("::io_uring_register_ring_fd failed: {}", std::error_code(-res, std::system_category()).message());
   }
   current_ring = this;
+  armWakeup();
   running_.store(true, std::memory_order_release);
   on_started();
   bool more_work = on_progress();
@@ -154,6 +236,7 @@ void IoRing::run(const std::function<void()>& on_started, const std::function<bo
     runOnce(!more_work);
     more_work = on_progress();
   }
+  running_.store(false, std::memory_order_release);
   res = ::io_uring_unregister_ring_fd(&ring_);
 
   if (res < 0) {
@@ -171,16 +254,86 @@ auto IoRing::isRunning() -> bool {
   return running_.load(std::memory_order_acquire);
 }
 
+auto IoRing::poll() -> bool {
+  if (::io_uring_sq_ready(&ring_) > 0) {
+    const int res = ::io_uring_submit(&ring_);
+    if (res < 0 && !(-res == EAGAIN || -res == EINTR)) {
+      panic("::io_uring_submit failed: {}", std::error_code(-res, std::system_category()).message());
+    }
+  }
+  if (config_.defer_taskrun) {
+    // Completions are only posted once the kernel got entered to process them.
+    (void)::io_uring_get_events(&ring_);
+  }
+  return ::io_uring_cq_ready(&ring_) > 0 || submissions_.load(std::memory_order_relaxed) != nullptr;
+}
+
+auto IoRing::registerFile(int fd) -> int {
+  const std::scoped_lock lock{ registered_files_mutex_ };
+  if (free_file_slots_.empty()) {
+    return -1;
+  }
+  const int slot = free_file_slots_.back();
+  const int res = updateRegisteredFile(ring_, slot, fd);
+  if (res < 0) {
+    return -1;
+  }
+  free_file_slots_.pop_back();
+  return slot;
+}
+
+void IoRing::unregisterFile(int index) noexcept {
+  const std::scoped_lock lock{ registered_files_mutex_ };
+  int fd = -1;
+  // A slot which failed to get cleared still refers to the old file, it is not handed out again.
+  if (updateRegisteredFile(ring_, index, fd) >= 0) {
+    free_file_slots_.push_back(index);
+  }
+}
+
+auto IoRing::fixedBuffer(std::size_t index) -> std::span<std::byte> {
+  if (index >= config_.fixed_buffer_count) {
+    panic("Fixed buffer index {} out of range, ring has {} buffers", index, config_.fixed_buffer_count);
+  }
+  return std::span{ fixed_buffers_ }.subspan(index * config_.fixed_buffer_size, config_.fixed_buffer_size);
+}
+
+auto IoRing::findFixedBuffer(std::span<const std::byte> buffer) const -> int {
+  if (fixed_buffers_.empty() || buffer.empty()) {
+    return -1;
+  }
+  // The buffers are laid out contiguously, compare addresses rather than pointers of unrelated objects.
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto begin = reinterpret_cast<std::uintptr_t>(fixed_buffers_.data());
+  const auto address = reinterpret_cast<std::uintptr_t>(buffer.data());
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (address < begin || address - begin >= fixed_buffers_.size()) {
+    return -1;
+  }
+  const auto index = (address - begin) / config_.fixed_buffer_size;
+  if (address - begin + buffer.size() > (index + 1) * config_.fixed_buffer_size) {
+    return -1;
+  }
+  return static_cast<int>(index);
+}
+
 void IoRing::submit(IoRingOperationBase* operation) {
   // We need to dispatch to our ring if we are calling this function from outside
   // the event loop
   if (!isCurrentRing() && isRunning()) {
-    DispatchOperation dispatch;
-    dispatch.destination = this;
-    dispatch.operation = operation;
-    dispatch.run();
+    // When being called from within another event loop, the operation is handed over without
+    // waiting for the destination to pick it up.
+    if (current_ring != nullptr &&
+        current_ring->sendMessage(this, toUserData(operation) | SUBMIT_MESSAGE_TAG)) {
+      return;
+    }
+    enqueueSubmission(operation);
     return;
   }
+  prepareSubmission(operation);
+}
+
+void IoRing::prepareSubmission(IoRingOperationBase* operation) {
   auto* sqe = getSqe();
 
   operation->prepare(sqe);
@@ -188,6 +341,64 @@ void IoRing::submit(IoRingOperationBase* operation) {
   ::io_uring_sqe_set_data(sqe, operation);
 }
 
+void IoRing::enqueueSubmission(IoRingOperationBase* operation) {
+  // Keeps the ring running until the operation got submitted.
+  in_flight_.fetch_add(1, std::memory_order_release);
+  auto* head = submissions_.load(std::memory_order_relaxed);
+  do {
+    operation->next_submission_ = head;
+  } while (!submissions_.compare_exchange_weak(head, operation, std::memory_order_release,
+                                               std::memory_order_relaxed));
+  // Only the first operation of a batch needs to wake up the ring, the others are picked up with it.
+  if (head == nullptr && ::eventfd_write(wakeup_fd_, 1) < 0) {
+    panic("::eventfd_write failed: {}", std::error_code(errno, std::system_category()).message());
+  }
+}
+
+void IoRing::drainSubmissions() {
+  auto* head = submissions_.exchange(nullptr, std::memory_order_acquire);
+  // The queue is a stack, reverse it to submit in the order of queueing.
+  IoRingOperationBase* reversed{ nullptr };
+  while (head != nullptr) {
+    auto* next = head->next_submission_;
+    head->next_submission_ = reversed;
+    reversed = head;
+    head = next;
+  }
+  while (reversed != nullptr) {
+    auto* operation = reversed;
+    reversed = reversed->next_submission_;
+    operation->next_submission_ = nullptr;
+    prepareSubmission(operation);
+    in_flight_.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void IoRing::armWakeup() {
+  if (wakeup_armed_) {
+    return;
+  }
+  auto* sqe = getSqe();
+  if (sqe == nullptr) {
+    return;
+  }
+  in_flight_.fetch_sub(1, std::memory_order_release);
+  ::io_uring_prep_read(sqe, wakeup_fd_, &wakeup_value_, sizeof(wakeup_value_), 0);
+  ::io_uring_sqe_set_data64(sqe, WAKEUP_MESSAGE);
+  wakeup_armed_ = true;
+}
+
+auto IoRing::sendMessage(IoRing* destination, std::uint64_t data) -> bool {
+  auto* sqe = getSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  destination->in_flight_.fetch_add(1, std::memory_order_release);
+  ::io_uring_prep_msg_ring(sqe, destination->ring_.ring_fd, 0, data, 0);
+  ::io_uring_sqe_set_data(sqe, nullptr);
+  return true;
+}
+
 auto IoRing::getSqe() -> ::io_uring_sqe* {
   while (!stop_source_.stop_requested() || in_flight_.load(std::memory_order_acquire) > 0) {
     if (::io_uring_sqe* sqe = ::io_uring_get_sqe(&ring_); sqe != nullptr) {
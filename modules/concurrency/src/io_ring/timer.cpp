@@ -9,7 +9,6 @@
 #include <chrono>
 #include <cstdint>
 #include <cstring>
-#include <functional>
 #include <limits>
 #include <system_error>
 
@@ -47,14 +46,8 @@ void Timer::Operation::handleCompletion(::io_uring_cqe* cqe) const {
 }
 
 void Timer::Operation::handleStopped() const {
-  while (!timer->tasks_.empty()) {
-    auto entry = timer->tasks_.front();
-
-    std::ranges::pop_heap(timer->tasks_, std::greater<>{});
-    timer->tasks_.pop_back();
-
-    entry.task->setStopped();
-  }
+  timer->armed_tick_ = TimingWheel<TaskBase>::NO_TICK;
+  timer->wheel_.clear([](TaskBase* task) { task->setStopped(); });
 }
 
 void Timer::UpdateOperation::handleStopped() {
@@ -102,7 +95,10 @@ void Timer::UpdateOperation::prepare(::io_uring_sqe* sqe) const {
 void Timer::UpdateOperation::handleCompletion(::io_uring_cqe* cqe) const {
   if (cqe->res < 0) {
     if (cqe->res == -ENOENT || cqe->res == -EALREADY) {
-      timer->tick();
+      // The timeout already expired, resetting destroys this operation.
+      auto* self = timer;
+      self->update_timer_operation_.reset();
+      self->tick();
       return;
     }
     panic("timer failed: {}", std::error_code(-cqe->res, std::system_category()).message());
@@ -123,7 +119,9 @@ Timer::Timer(IoRing& ring, TimerOptions options)
   , start_(std::chrono::duration_cast<TimerClock::duration>(TimerClock::base_clock::now() -
                                                             TimerClock::base_clock::time_point{}))
   , last_tick_(start_)
-  , clock_mode_(options.clock_mode) {
+  , clock_mode_(options.clock_mode)
+  , resolution_(std::max(options.resolution, std::chrono::microseconds{ 1 }))
+  , wheel_(static_cast<std::uint64_t>(start_.time_since_epoch() / resolution_)) {
   if (clock_mode_ == ClockMode::SIMULATED) {
     TimerClock::timer = this;
   }
@@ -134,75 +132,72 @@ Timer::~Timer() noexcept {
 }
 
 void Timer::tick() {
-  for (TaskBase* task = next(); task != nullptr; task = next()) {
-    task->start();
-  }
+  // The armed timeout expired, or got removed while being updated.
+  armed_tick_ = TimingWheel<TaskBase>::NO_TICK;
+  const auto now = TimerClock::now();
+  if (const auto next = wheel_.nextExpiry(); next != TimingWheel<TaskBase>::NO_TICK && timeOf(next) <= now) {
+    const auto latency = now - timeOf(next);
+    ++wakeup_statistics_.wakeups;
+    wakeup_statistics_.total_latency += latency;
+    wakeup_statistics_.max_latency = std::max(wakeup_statistics_.max_latency, latency);
+  }
+  startDue(now);
   last_tick_ = TimerClock::now();
-  if (!tasks_.empty()) {
-    const auto& top = tasks_.front();
-    update(top.start_time);
-  }
+  arm(wheel_.nextExpiry());
 }
 
 auto Timer::tickSimulated(bool advance) -> bool {
-  if (tasks_.empty()) {
+  if (wheel_.empty()) {
     return false;
   }
 
   if (advance) {
-    auto top = tasks_.front();
-    std::ranges::pop_heap(tasks_, std::greater<>{});
-    tasks_.pop_back();
-    if (top.start_time > last_tick_) {
-      advanceSimulation(top.start_time - last_tick_);
+    const auto next = timeOf(wheel_.nextExpiry());
+    if (next > last_tick_) {
+      advanceSimulation(next - last_tick_);
     }
-    top.task->start();
-    return !tasks_.empty();
   }
 
-  TaskBase* task = next();
-  if (task != nullptr) {
-    task->start();
-  }
-  return !tasks_.empty();
+  startDue(last_tick_);
+  return !wheel_.empty();
 }
 
 void Timer::startAt(TaskBase* task, TimerClock::time_point start_time) {
-  tasks_.emplace_back(task, start_time);
-  std::ranges::push_heap(tasks_, std::greater<>{});
-
-  const auto& top = tasks_.front();
+  wheel_.insert(task, tickOf(start_time));
 
-  if (top.task != task || clock_mode_ == ClockMode::SIMULATED) {
+  if (clock_mode_ == ClockMode::SIMULATED) {
     return;
   }
 
-  update(start_time);
+  // Only the new task can start before the armed timeout.
+  arm(task->timer_tick);
 }
 
 void Timer::dequeue(TaskBase* task) {
-  auto it = std::ranges::find_if(tasks_, [task](const TimerEntry& entry) { return task == entry.task; });
-  if (it == tasks_.end()) {
+  // Leaves the timeout armed, expiring without tasks to start is cheaper than updating it.
+  (void)wheel_.erase(task);
+}
+
+void Timer::arm(std::uint64_t tick) {
+  if (tick == TimingWheel<TaskBase>::NO_TICK || tick >= armed_tick_) {
     return;
   }
-  tasks_.erase(it);
-  std::ranges::make_heap(tasks_, std::greater<>{});
-}
-
-auto Timer::next(bool advance) -> TaskBase* {
-  if (!tasks_.empty()) {
-    auto now = TimerClock::now();
-    const auto& top = tasks_.front();
-    if (top.start_time <= now) {
-      auto* task = top.task;
-      if (advance) {
-        last_tick_ += (top.start_time - last_tick_);
-      }
-      std::ranges::pop_heap(tasks_, std::greater<>{});
-      tasks_.pop_back();
-      return task;
-    }
-  }
-  return nullptr;
+  armed_tick_ = tick;
+  update(timeOf(tick));
+}
+
+void Timer::startDue(TimerClock::time_point now) {
+  wheel_.advance(static_cast<std::uint64_t>(now.time_since_epoch() / resolution_),
+                 [](TaskBase* task) { task->start(); });
+}
+
+auto Timer::tickOf(TimerClock::time_point time) const -> std::uint64_t {
+  // Rounded up, tasks never start before their start time.
+  const auto since_epoch = std::max(time.time_since_epoch(), TimerClock::duration{ 0 });
+  return static_cast<std::uint64_t>((since_epoch + resolution_ - TimerClock::duration{ 1 }) / resolution_);
+}
+
+auto Timer::timeOf(std::uint64_t tick) const -> TimerClock::time_point {
+  return TimerClock::time_point{ resolution_ * static_cast<TimerClock::rep>(tick) };
 }
 }  // namespace heph::concurrency::io_ring
@@ -237,4 +237,90 @@ TEST(ContextTests, scheduleAfterStopWaitingSimulated) {
   EXPECT_LE(context.elapsed(), delay_time * 2);
 }
 
+TEST(ContextTests, scheduleEarliestDeadlineFirst) {
+  Context context{ { .io_ring_config = {},
+                     .timer_options = {},
+                     .ready_queue_policy = ReadyQueuePolicy::EARLIEST_DEADLINE_FIRST } };
+  exec::async_scope scope;
+  std::vector<int> call_sequence;
+  const std::vector<int> call_sequence_ref{ 3, 2, 1 };
+  static constexpr auto DELAY_TIME = std::chrono::milliseconds(10);
+
+  // All tasks are ready right away, they run ordered by their deadlines.
+  const auto now = io_ring::TimerClock::now();
+  scope.spawn(context.scheduler().scheduleAt(now - DELAY_TIME, now + DELAY_TIME * 2) |
+              stdexec::then([&context, &call_sequence] {
+                call_sequence.push_back(1);
+                context.requestStop();
+              }));
+  scope.spawn(context.scheduler().scheduleAt(now - DELAY_TIME, now + DELAY_TIME) |
+              stdexec::then([&call_sequence] { call_sequence.push_back(2); }));
+  scope.spawn(context.scheduler().schedule() |
+              stdexec::then([&call_sequence] { call_sequence.push_back(3); }));
+
+  context.run();
+  stdexec::sync_wait(scope.on_empty());
+  EXPECT_EQ(call_sequence, call_sequence_ref);
+}
+
+TEST(ContextTests, busyPoll) {
+  static constexpr auto DELAY_TIME = std::chrono::milliseconds(2);
+  Context context{ { .io_ring_config = {},
+                     .timer_options = {},
+                     .ready_queue_policy = ReadyQueuePolicy::FIFO,
+                     .busy_poll = { .policy = IdlePolicy::BUSY_POLL, .window = DELAY_TIME * 100 } } };
+  exec::async_scope scope;
+  bool called{ false };
+  scope.spawn(context.scheduler().scheduleAfter(DELAY_TIME) | stdexec::then([&context, &called] {
+                called = true;
+                context.requestStop();
+              }));
+
+  context.run();
+  stdexec::sync_wait(scope.on_empty());
+  EXPECT_TRUE(called);
+
+  // The timer expired while spinning, the context never blocked to get woken up by it.
+  const auto statistics = context.idleStatistics();
+  EXPECT_GE(statistics.spins, 1);
+  EXPECT_GE(statistics.spin_hits, 1);
+  EXPECT_GT(statistics.spin_time, std::chrono::nanoseconds{ 0 });
+  EXPECT_EQ(statistics.timer_wakeups, 1);
+  EXPECT_LE(statistics.wakeup_latency_max, DELAY_TIME * 100);
+}
+
+TEST(ContextTests, taskBudget) {
+  static constexpr std::size_t MAX_TASKS = 4;
+  static constexpr std::size_t NUMBER_OF_TASKS = 10;
+  Context context{ { .io_ring_config = {},
+                     .timer_options = {},
+                     .ready_queue_policy = ReadyQueuePolicy::FIFO,
+                     .busy_poll = {},
+                     .task_budget = { .max_tasks = MAX_TASKS, .max_duration = {} } } };
+  exec::async_scope scope;
+  std::size_t called{ 0 };
+  for (std::size_t i = 0; i != NUMBER_OF_TASKS; ++i) {
+    scope.spawn(context.scheduler().schedule() | stdexec::then([&context, &called] {
+                  if (++called == NUMBER_OF_TASKS) {
+                    context.requestStop();
+                  }
+                }));
+  }
+
+  context.run();
+  stdexec::sync_wait(scope.on_empty());
+  EXPECT_EQ(called, NUMBER_OF_TASKS);
+
+  // The ready tasks got run in batches of the budget, polling the ring in between.
+  const auto statistics = context.runStatistics();
+  EXPECT_EQ(statistics.tasks, NUMBER_OF_TASKS);
+  EXPECT_EQ(statistics.max_tasks_per_poll, MAX_TASKS);
+  EXPECT_GE(statistics.polls, 3);
+  EXPECT_GT(statistics.pollsPerSecond(), 0.0);
+
+  // The duration ends with the run.
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+  EXPECT_EQ(context.runStatistics().duration, statistics.duration);
+}
+
 }  // namespace heph::concurrency::tests
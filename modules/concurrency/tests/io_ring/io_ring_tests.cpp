@@ -2,6 +2,7 @@
 // Copyright (C) 2023-2025 HEPHAESTUS Contributors
 //=================================================================================================
 
+#include <array>
 #include <cerrno>
 #include <condition_variable>
 #include <cstddef>
@@ -16,6 +17,7 @@
 #include <liburing.h>  // NOLINT(misc-include-cleaner)
 #include <liburing/compat.h>
 #include <liburing/io_uring.h>
+#include <unistd.h>
 
 #include "hephaestus/concurrency/io_ring/io_ring.h"
 #include "hephaestus/concurrency/io_ring/io_ring_operation_base.h"
@@ -125,6 +127,87 @@ TEST(IoRingTest, submitConcurrent) {
   EXPECT_EQ(completions, static_cast<std::size_t>(config.nentries * 3));
 }
 
+TEST(IoRingTest, submitConcurrentProducers) {
+  static constexpr std::size_t NUMBER_OF_PRODUCERS = 4;
+  static constexpr std::size_t OPERATIONS_PER_PRODUCER = 256;
+  const IoRingConfig config;
+  std::mutex mtx;
+  std::condition_variable cv;
+  IoRing* ring_ptr{ nullptr };
+
+  // Completions are handled on the thread of the ring only.
+  std::size_t completions = 0;
+  std::vector<DummyOperation> ops(NUMBER_OF_PRODUCERS * OPERATIONS_PER_PRODUCER);
+  for (DummyOperation& op : ops) {
+    op.completions = &completions;
+  }
+
+  std::thread runner{ [&config, &mtx, &cv, &ring_ptr] {
+    IoRing ring{ config };
+    ring.run([&] {
+      {
+        const std::scoped_lock l{ mtx };
+        ring_ptr = &ring;
+      }
+      cv.notify_all();
+    });
+  } };
+
+  {
+    std::unique_lock l{ mtx };
+    cv.wait(l, [&ring_ptr] { return ring_ptr != nullptr; });
+  }
+
+  {
+    std::vector<std::jthread> producers;
+    for (std::size_t i = 0; i != NUMBER_OF_PRODUCERS; ++i) {
+      producers.emplace_back([&ops, ring_ptr, i] {
+        for (std::size_t j = 0; j != OPERATIONS_PER_PRODUCER; ++j) {
+          ring_ptr->submit(&ops[(i * OPERATIONS_PER_PRODUCER) + j]);
+        }
+      });
+    }
+  }
+
+  ring_ptr->requestStop();
+  runner.join();
+  EXPECT_EQ(completions, NUMBER_OF_PRODUCERS * OPERATIONS_PER_PRODUCER);
+}
+
+TEST(IoRingTest, registeredFiles) {
+  IoRing ring{ { .registered_files = 2 } };
+  std::array<int, 2> pipe_fds{};
+  ASSERT_EQ(::pipe(pipe_fds.data()), 0);
+
+  const int first = ring.registerFile(pipe_fds[0]);
+  const int second = ring.registerFile(pipe_fds[1]);
+  EXPECT_GE(first, 0);
+  EXPECT_GE(second, 0);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(ring.registerFile(pipe_fds[0]), -1);
+
+  ring.unregisterFile(first);
+  EXPECT_EQ(ring.registerFile(pipe_fds[0]), first);
+
+  ::close(pipe_fds[0]);
+  ::close(pipe_fds[1]);
+}
+
+TEST(IoRingTest, fixedBuffers) {
+  static constexpr std::size_t BUFFER_SIZE = 64;
+  IoRing ring{ { .fixed_buffer_count = 2, .fixed_buffer_size = BUFFER_SIZE } };
+
+  auto buffer = ring.fixedBuffer(1);
+  EXPECT_EQ(buffer.size(), BUFFER_SIZE);
+  EXPECT_EQ(ring.findFixedBuffer(buffer), 1);
+  EXPECT_EQ(ring.findFixedBuffer(ring.fixedBuffer(0).subspan(8, 16)), 0);
+  // Spanning both buffers
+  EXPECT_EQ(ring.findFixedBuffer({ ring.fixedBuffer(0).data() + 8, BUFFER_SIZE }), -1);
+
+  std::array<std::byte, BUFFER_SIZE> other{};
+  EXPECT_EQ(ring.findFixedBuffer(other), -1);
+}
+
 struct TestOperation1T {
   void prepare(io_uring_sqe* sqe) {
     ::io_uring_prep_timeout(sqe, &ts, 0, 0);
@@ -0,0 +1,49 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "hephaestus/concurrency/context_scheduler.h"
+#include "hephaestus/concurrency/io_ring/io_ring.h"
+#include "hephaestus/concurrency/io_ring/timer.h"
+
+namespace heph::concurrency::io_ring::tests {
+namespace {
+struct StopRingTask : TaskBase {
+  IoRing* ring{ nullptr };
+  TimerClock::time_point started_at;
+  bool started{ false };
+
+  void start() noexcept final {
+    started_at = TimerClock::now();
+    started = true;
+    ring->requestStop();
+  }
+  void setValue() noexcept final {
+  }
+  void setStopped() noexcept final {
+  }
+};
+}  // namespace
+
+TEST(Timer, wakesUpOncePerStart) {
+  // Far enough to wait in a coarse level of the wheel, cascading twice before expiring.
+  static constexpr std::chrono::milliseconds DELAY{ 100 };
+  IoRing ring{ {} };
+  Timer timer{ ring, {} };
+
+  StopRingTask task;
+  task.ring = &ring;
+  const auto start_time = TimerClock::now() + DELAY;
+  timer.startAt(&task, start_time);
+  ring.run();
+
+  ASSERT_TRUE(task.started);
+  EXPECT_GE(task.started_at, start_time);
+  EXPECT_EQ(timer.wakeupStatistics().wakeups, 1);
+  EXPECT_TRUE(timer.empty());
+}
+}  // namespace heph::concurrency::io_ring::tests
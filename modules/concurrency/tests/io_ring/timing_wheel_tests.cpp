@@ -0,0 +1,118 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hephaestus/concurrency/io_ring/timing_wheel.h"
+
+namespace heph::concurrency::io_ring::tests {
+namespace {
+struct Element {
+  Element* timer_next{ nullptr };
+  Element* timer_prev{ nullptr };
+  std::uint64_t timer_tick{ 0 };
+  std::uint32_t timer_slot{ TIMING_WHEEL_NO_SLOT };
+};
+
+auto expire(TimingWheel<Element>& wheel, std::uint64_t tick) -> std::vector<Element*> {
+  std::vector<Element*> expired;
+  wheel.advance(tick, [&expired](Element* element) { expired.push_back(element); });
+  return expired;
+}
+}  // namespace
+
+TEST(TimingWheel, expiresInOrder) {
+  static constexpr std::uint64_t START = 1000;
+  TimingWheel<Element> wheel{ START };
+  // Spread across the first levels of the wheel.
+  const std::vector<std::uint64_t> delays{ 0, 1, 63, 64, 65, 4095, 4096, 300000, 20000000 };
+  std::vector<Element> elements(delays.size());
+  for (std::size_t i = 0; i != elements.size(); ++i) {
+    wheel.insert(&elements[i], START + delays[i]);
+  }
+  EXPECT_EQ(wheel.size(), elements.size());
+
+  for (std::size_t i = 0; i != elements.size(); ++i) {
+    const auto due = START + delays[i];
+    if (delays[i] != 0) {
+      EXPECT_TRUE(expire(wheel, due - 1).empty());
+    }
+    EXPECT_EQ(expire(wheel, due), std::vector<Element*>{ &elements[i] });
+  }
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.nextTick(), TimingWheel<Element>::NO_TICK);
+}
+
+TEST(TimingWheel, erase) {
+  TimingWheel<Element> wheel;
+  Element first;
+  Element second;
+  wheel.insert(&first, 10);
+  wheel.insert(&second, 10);
+
+  EXPECT_TRUE(wheel.erase(&first));
+  EXPECT_FALSE(wheel.erase(&first));
+  EXPECT_EQ(expire(wheel, 10), std::vector<Element*>{ &second });
+  EXPECT_FALSE(wheel.erase(&second));
+}
+
+TEST(TimingWheel, pastTicksExpireRightAway) {
+  static constexpr std::uint64_t START = 500;
+  TimingWheel<Element> wheel{ START };
+  Element element;
+  wheel.insert(&element, START - 100);
+  EXPECT_EQ(wheel.nextTick(), START);
+  EXPECT_EQ(expire(wheel, START), std::vector<Element*>{ &element });
+}
+
+TEST(TimingWheel, overflow) {
+  // Beyond the range of all levels.
+  static constexpr std::uint64_t FAR = std::uint64_t{ 1 } << 40;
+  TimingWheel<Element> wheel;
+  Element element;
+  wheel.insert(&element, FAR + 3);
+  EXPECT_LE(wheel.nextTick(), FAR);
+  EXPECT_TRUE(expire(wheel, FAR + 2).empty());
+  EXPECT_EQ(wheel.nextTick(), FAR + 3);
+  EXPECT_EQ(expire(wheel, FAR + 3), std::vector<Element*>{ &element });
+}
+
+TEST(TimingWheel, nextExpirySkipsCascades) {
+  TimingWheel<Element> wheel;
+  std::vector<Element> elements(3);
+  // Both wait in coarser levels, cascading at tick 64 and 4096 before expiring.
+  wheel.insert(&elements[0], 5000);
+  wheel.insert(&elements[1], 4200);
+  EXPECT_EQ(wheel.nextTick(), 4096);
+  EXPECT_EQ(wheel.nextExpiry(), 4200);
+
+  wheel.insert(&elements[2], 70);
+  EXPECT_EQ(wheel.nextTick(), 64);
+  EXPECT_EQ(wheel.nextExpiry(), 70);
+
+  EXPECT_EQ(expire(wheel, wheel.nextExpiry()), std::vector<Element*>{ &elements[2] });
+  EXPECT_EQ(wheel.nextExpiry(), 4200);
+  EXPECT_EQ(expire(wheel, wheel.nextExpiry()), std::vector<Element*>{ &elements[1] });
+  EXPECT_EQ(wheel.nextExpiry(), 5000);
+  EXPECT_TRUE(wheel.erase(&elements[0]));
+  EXPECT_EQ(wheel.nextExpiry(), TimingWheel<Element>::NO_TICK);
+}
+
+TEST(TimingWheel, clear) {
+  TimingWheel<Element> wheel;
+  std::vector<Element> elements(3);
+  wheel.insert(&elements[0], 1);
+  wheel.insert(&elements[1], 1000);
+  wheel.insert(&elements[2], std::uint64_t{ 1 } << 50);
+
+  std::size_t cleared = 0;
+  wheel.clear([&cleared](Element* /*element*/) { ++cleared; });
+  EXPECT_EQ(cleared, elements.size());
+  EXPECT_TRUE(wheel.empty());
+}
+}  // namespace heph::concurrency::io_ring::tests
@@ -33,6 +33,23 @@ TEST(WhenAllRange, Basic) {
   EXPECT_EQ(completed, NUMBER_OF_SENDERS);
 }
 
+TEST(WhenAllRange, Bounded) {
+  std::vector<AnySender<void>> senders;
+
+  std::size_t completed{ 0 };
+  static constexpr std::size_t MAX_NUMBER_OF_SENDERS{ 100 };
+  auto res = stdexec::sync_wait(whenAllRange<MAX_NUMBER_OF_SENDERS>(std::vector<AnySender<void>>{}));
+  EXPECT_TRUE(res.has_value());
+
+  for (std::size_t i = 0; i != MAX_NUMBER_OF_SENDERS / 2; ++i) {
+    senders.emplace_back(stdexec::just() | stdexec::then([&completed]() { ++completed; }));
+  }
+  res = stdexec::sync_wait(whenAllRange<MAX_NUMBER_OF_SENDERS>(std::move(senders)));
+
+  EXPECT_TRUE(res.has_value());
+  EXPECT_EQ(completed, MAX_NUMBER_OF_SENDERS / 2);
+}
+
 TEST(WhenAllRange, Stop) {
   std::vector<AnySender<void>> senders;
 
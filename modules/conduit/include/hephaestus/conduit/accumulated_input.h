@@ -38,9 +38,8 @@ public:
       return std::nullopt;
     }
     R res{ initial_value_ };
-    for (auto& element : this->buffer_.peekAll()) {
-      res = f_(std::move(element), res);
-    }
+    reserve(res);
+    this->buffer_.forEach([this, &res](const T& element) { accumulate(T{ element }, res); });
     return res;
   }
 
@@ -49,19 +48,31 @@ public:
       return std::nullopt;
     }
     R res{ initial_value_ };
-    while (true) {
-      auto element = this->buffer_.pop();
-      if (!element.has_value()) {
-        break;
-      }
-      res = f_(std::move(element.value()), res);
-    }
+    reserve(res);
+    this->drainValues([this, &res](T&& element) { accumulate(std::move(element), res); });
     return res;
   }
 
   template <typename Receiver, bool Peek>
   using Awaiter = detail::Awaiter<AccumulatedTransformInputBase, std::decay_t<Receiver>, Peek>;
 
+private:
+  /// Accumulators either fold the element into the state in place (`void(T, R&)`), or return the
+  /// new state (`R(T, R&)`).
+  void accumulate(T&& element, R& res) {
+    if constexpr (std::is_void_v<std::invoke_result_t<F&, T, R&>>) {
+      std::invoke(f_, std::move(element), res);
+    } else {
+      res = std::invoke(f_, std::move(element), res);
+    }
+  }
+
+  void reserve(R& res) {
+    if constexpr (requires { res.reserve(res.size() + this->buffer_.size()); }) {
+      res.reserve(res.size() + this->buffer_.size());
+    }
+  }
+
 private:
   F f_;
   R initial_value_;
@@ -72,9 +83,8 @@ using AccumulatedTransformInput = AccumulatedTransformInputBase<T, R, std::funct
 
 namespace internal {
 template <typename T>
-auto accumulator(T value, std::vector<T>& state) -> std::vector<T> {
-  state.push_back(value);
-  return state;
+void accumulator(T value, std::vector<T>& state) {
+  state.push_back(std::move(value));
 }
 }  // namespace internal
 
@@ -24,6 +24,18 @@ private:
   [[maybe_unused]] AwaiterBase* prev_{ nullptr };
 };
 
+/// Waits on a full input until a value got consumed from it.
+class SlotAwaiterBase {
+public:
+  virtual ~SlotAwaiterBase() = default;
+  virtual void slotAvailable() = 0;
+
+private:
+  friend struct containers::IntrusiveFifoQueueAccess;
+  [[maybe_unused]] SlotAwaiterBase* next_{ nullptr };
+  [[maybe_unused]] SlotAwaiterBase* prev_{ nullptr };
+};
+
 template <typename InputT, typename ReceiverT, bool Peek>
 class Awaiter : public AwaiterBase {
   struct StopCallback {
@@ -7,7 +7,7 @@
 #include <array>
 #include <cstddef>
 #include <optional>
-#include <vector>
+#include <utility>
 
 namespace heph::conduit::detail {
 template <typename T, std::size_t Capacity>
@@ -46,18 +46,28 @@ public:
     return std::optional{ data_[read_index_] };
   }
 
-  auto peekAll() -> std::vector<T> {
-    std::vector<T> res;
-    if (size_ == 0) {
-      return res;
-    }
-    res.reserve(size_);
+  /// Returns the oldest element without copying it, nullptr if empty.
+  [[nodiscard]] auto front() const -> const T* {
+    return size_ == 0 ? nullptr : &data_[read_index_];
+  }
+
+  /// Calls `f` for every element, starting with the oldest one.
+  template <typename F>
+  void forEach(F&& f) const {
     std::size_t index = read_index_;
     for (std::size_t i = size_; i != 0; --i) {
-      res.push_back(data_[index]);
+      f(data_[index]);
       index = (index + 1) % data_.size();
     }
-    return res;
+  }
+
+  /// Moves every element into `f`, starting with the oldest one, and empties the buffer.
+  template <typename F>
+  void drain(F&& f) {
+    for (; size_ != 0; --size_) {
+      f(std::move(data_[read_index_]));
+      read_index_ = (read_index_ + 1) % data_.size();
+    }
   }
 
   auto size() -> std::size_t {
@@ -88,10 +98,29 @@ public:
     return data_;
   }
 
+  [[nodiscard]] auto front() const -> const T* {
+    return data_.has_value() ? &*data_ : nullptr;
+  }
+
   auto pop() -> std::optional<T> {
     return std::exchange(data_, std::optional<T>{});
   }
 
+  template <typename F>
+  void forEach(F&& f) const {
+    if (data_.has_value()) {
+      f(*data_);
+    }
+  }
+
+  template <typename F>
+  void drain(F&& f) {
+    if (data_.has_value()) {
+      f(std::move(*data_));
+      data_.reset();
+    }
+  }
+
   auto size() -> std::size_t {
     return data_.has_value() ? 1 : 0;
   }
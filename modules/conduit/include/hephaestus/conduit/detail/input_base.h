@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -21,14 +25,17 @@
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/concurrency/io_ring/io_ring.h"
+#include "hephaestus/concurrency/io_ring/io_ring_operation_base.h"
 #include "hephaestus/conduit/detail/awaiter.h"
 #include "hephaestus/conduit/detail/circular_buffer.h"
 #include "hephaestus/conduit/input.h"
 #include "hephaestus/conduit/node.h"
 #include "hephaestus/conduit/node_handle.h"
 #include "hephaestus/conduit/output.h"
+#include "hephaestus/conduit/trace_context.h"
+#include "hephaestus/containers/bounded_mpsc_queue.h"
 #include "hephaestus/containers/intrusive_fifo_queue.h"
-#include "hephaestus/error_handling/panic.h"
 #include "hephaestus/utils/utils.h"
 
 namespace heph::conduit {
@@ -59,6 +66,9 @@ public:
         .name = name_,
         .node_name = node_->nodeName(),
         .type = heph::utils::getTypeName<DataT>(),
+        .borrows = ISSHAREDVALUE<DataT>,
+        .overflows = overflow_count_.load(std::memory_order_relaxed),
+        .fusable = Depth == 1 && InputT::InputPolicyT::RETRIEVAL_METHOD == RetrievalMethod::BLOCK,
       };
     });
   }
@@ -96,7 +106,6 @@ public:
 
   template <typename OperationT, typename DataT>
   void connectTo(Node<OperationT, DataT>& node) {
-    using ValueT = typename InputT::ValueT;
     using ExecuteOperationT = decltype(node.executeSender());
     using ExecuteResultVariantT = stdexec::__sync_wait::__sync_wait_with_variant_result_t<ExecuteOperationT>;
     static_assert(std::variant_size_v<ExecuteResultVariantT> == 1);
@@ -106,17 +115,17 @@ public:
                   "Node returning more than one output should be impossible");
     using ResultT = std::tuple_element_t<0, ExecuteResultTupleT>;
     if constexpr (detail::ISOPTIONAL<ResultT>) {
-      static_assert(std::is_same_v<ValueT, typename std::decay_t<ResultT>::value_type>,
+      static_assert(ACCEPTS_OUTPUT<typename std::decay_t<ResultT>::value_type>,
                     "Input and output types don't match");
     } else {
-      static_assert(std::is_same_v<ValueT, ResultT>, "Input and output types don't match");
+      static_assert(ACCEPTS_OUTPUT<ResultT>, "Input and output types don't match");
     }
     node.registerInput(static_cast<InputT*>(this));
   }
 
   template <typename U>
   void connectTo(Output<U>& output) {
-    static_assert(std::is_same_v<U, T>, "Input and output types don't match");
+    static_assert(ACCEPTS_OUTPUT<U>, "Input and output types don't match");
     output.registerInput(static_cast<InputT*>(this));
   }
 
@@ -125,32 +134,49 @@ public:
     connectTo(*node);
   }
 
+  /// Sets the value of the input. When called from outside the context of the node, the value is
+  /// staged and handed over without waiting for the context. For blocking inputs,
+  /// `InputState::OVERFLOW` is returned if the context didn't pick up previously staged values yet,
+  /// overwriting inputs replace the newest staged value instead.
+  /// `trace` is accounted to the node once the value gets consumed.
   template <typename U>
-  auto setValue(U&& u) -> InputState {
+  auto setValue(U&& u, const TraceContext& trace = {}) -> InputState {
     if (!node_->runsOnEngine()) {
-      // Dispatch to the engine scheduler to avoid race conditions
-      auto res =
-          stdexec::sync_wait(node_->scheduler().schedule() | stdexec::then([this, u = std::forward<U>(u)] {
-                               return setValue(std::move(u));
-                             }));
-      if (!res.has_value()) {
-        panic("Could not set value, engine was stopped");
-      }
-      return std::get<0>(*res);
+      return stageValue(Staged{ .value = T(std::forward<U>(u)), .trace = trace });
     }
-    auto push_result = buffer_.push(std::forward<U>(u));
-    if (!push_result) {
+    if (buffer_.size() == Depth) {
       if (InputT::InputPolicyT::SET_METHOD == SetMethod::BLOCK) {
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        node_->recordInputOverflow();
         return InputState::OVERFLOW;
       }
-      buffer_.pop();
-      return setValue(std::forward<U>(u));
+      (void)buffer_.pop();
+      (void)traces_.pop();
     }
-    this->triggerAwaiter();
+    (void)buffer_.push(std::forward<U>(u));
+    (void)traces_.push(trace);
+    // Inputs may take over notifying awaiters, e.g. to combine several inputs.
+    static_cast<InputT*>(this)->triggerAwaiter();
     return InputState::OK;
   }
 
+  /// Registers `awaiter` to get notified once a value has been consumed. Used by outputs to wait on
+  /// inputs rejecting values with `InputState::OVERFLOW`.
+  void awaitSlot(SlotAwaiterBase* awaiter) {
+    if (containers::IntrusiveFifoQueueAccess::next(awaiter) == nullptr) {
+      slot_awaiters_.enqueue(awaiter);
+    }
+  }
+
+  void cancelAwaitSlot(SlotAwaiterBase* awaiter) {
+    (void)slot_awaiters_.erase(awaiter);
+  }
+
 private:
+  // Inputs of `SharedValue<U>` can be connected to outputs producing `U`, they then borrow the value.
+  template <typename U>
+  static constexpr bool ACCEPTS_OUTPUT = std::is_same_v<U, T> || std::is_same_v<U, SharedValueElementT<T>>;
+
   void enqueueWaiter(detail::AwaiterBase* awaiter) {
     if (containers::IntrusiveFifoQueueAccess::next(awaiter) == nullptr) {
       if (awaiter->isPeeker()) {
@@ -170,6 +196,34 @@ private:
   }
 
 protected:
+  auto popValue() -> std::optional<T> {
+    auto value = buffer_.pop();
+    if (value.has_value()) {
+      node_->consumeTrace(*traces_.pop());
+      triggerSlotAwaiters();
+    }
+    return value;
+  }
+
+  /// Drops the oldest value without accounting its trace.
+  void discardValue() {
+    if (buffer_.pop().has_value()) {
+      (void)traces_.pop();
+      triggerSlotAwaiters();
+    }
+  }
+
+  /// Moves all buffered values into `f`, oldest first.
+  template <typename F>
+  void drainValues(F&& f) {
+    if (buffer_.size() == 0) {
+      return;
+    }
+    buffer_.drain(std::forward<F>(f));
+    traces_.drain([this](const TraceContext& trace) { node_->consumeTrace(trace); });
+    triggerSlotAwaiters();
+  }
+
   void triggerAwaiter() {
     // First trigger all peekers, we need them to come first in order to observe
     // the value. An awaiter always consumes
@@ -188,6 +242,89 @@ protected:
     }
   }
 
+private:
+  struct Staged {
+    T value;
+    TraceContext trace;
+  };
+
+  struct DrainOperation : concurrency::io_ring::IoRingOperationBase {
+    explicit DrainOperation(InputBase* input) : self(input) {
+    }
+    void handleCompletion(::io_uring_cqe* /*cqe*/) final {
+      self->drainStaged();
+    }
+    InputBase* self;
+  };
+
+  auto stageValue(Staged&& staged) -> InputState {
+    if constexpr (InputT::InputPolicyT::SET_METHOD == SetMethod::OVERWRITE) {
+      // Once a value got overwritten, newer ones need to overwrite it as well to keep their order.
+      if (overwritten_pending_.load(std::memory_order_acquire) || !staging_.tryPush(std::move(staged))) {
+        const std::scoped_lock lock{ overwritten_mutex_ };
+        overwritten_ = std::move(staged);
+        overwritten_pending_.store(true, std::memory_order_release);
+      }
+    } else if (!staging_.tryPush(std::move(staged))) {
+      return InputState::OVERFLOW;
+    }
+    scheduleDrain();
+    return InputState::OK;
+  }
+
+  /// Takes the value overwritten while the staging queue was full, it is newer than all staged ones.
+  auto takeOverwritten() -> std::optional<Staged> {
+    if (!overwritten_pending_.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    const std::scoped_lock lock{ overwritten_mutex_ };
+    overwritten_pending_.store(false, std::memory_order_release);
+    return std::exchange(overwritten_, std::nullopt);
+  }
+
+  void scheduleDrain() {
+    if (!drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+      node_->scheduler().context().ring()->submit(&drain_operation_);
+    }
+  }
+
+  /// Moves staged values into the buffer, runs on the context of the node.
+  void drainStaged() {
+    // Reset first, values staged from now on schedule another drain.
+    drain_scheduled_.store(false, std::memory_order_release);
+    while (true) {
+      if (InputT::InputPolicyT::SET_METHOD == SetMethod::BLOCK && buffer_.size() == Depth) {
+        // Continued once a value got consumed.
+        return;
+      }
+      auto staged = staging_.tryPop();
+      if (!staged.has_value()) {
+        staged = takeOverwritten();
+      }
+      if (!staged.has_value()) {
+        return;
+      }
+      (void)setValue(std::move(staged->value), staged->trace);
+    }
+  }
+
+  void triggerSlotAwaiters() {
+    // Awaiters complete on the scheduler of the output, they can't enqueue themselves again while
+    // draining the queue.
+    while (true) {
+      auto* awaiter = slot_awaiters_.dequeue();
+      if (awaiter == nullptr) {
+        break;
+      }
+      awaiter->slotAvailable();
+    }
+    // Values of external producers are moved in asynchronously, we might be in the middle of
+    // completing an awaiter of this input.
+    if (!staging_.empty()) {
+      scheduleDrain();
+    }
+  }
+
 protected:
   // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
   // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
@@ -201,8 +338,23 @@ private:
 
   containers::IntrusiveFifoQueue<AwaiterBase> peekers_;
   containers::IntrusiveFifoQueue<AwaiterBase> awaiters_;
+  containers::IntrusiveFifoQueue<SlotAwaiterBase> slot_awaiters_;
   std::string name_;
   NodeBase* node_;
+  // Only modified on the context of the node, atomic to be read by specifications at any time.
+  std::atomic<std::uint64_t> overflow_count_{ 0 };
+
+  // Traces of the buffered values, kept in lockstep with `buffer_`.
+  detail::CircularBuffer<TraceContext, Depth> traces_;
+
+  // Values set from outside the context of the node, drained on the context in one batch.
+  containers::BoundedMpscQueue<Staged, std::max<std::size_t>(Depth, 2)> staging_;
+  std::atomic<bool> drain_scheduled_{ false };
+  // Newest value staged by an overwriting input while `staging_` was full, only locked on overflow.
+  std::mutex overwritten_mutex_;
+  std::optional<Staged> overwritten_;
+  std::atomic<bool> overwritten_pending_{ false };
+  DrainOperation drain_operation_{ this };
 };
 }  // namespace heph::conduit::detail
 
@@ -6,8 +6,11 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -15,9 +18,16 @@
 #include <vector>
 
 #include <hephaestus/concurrency/context.h>
+#include <stdexec/execution.hpp>
 #include <stdexec/stop_token.hpp>
 
+#include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/concurrency/context_scheduler.h"
 #include "hephaestus/conduit/detail/output_connections.h"
+#include "hephaestus/conduit/latency_histogram.h"
+#include "hephaestus/conduit/node_statistics.h"
+#include "hephaestus/conduit/trace_context.h"
+#include "hephaestus/telemetry/log/scope.h"
 
 // Forward declarations
 namespace heph::conduit {
@@ -33,6 +43,9 @@ struct InputSpecification {
   std::string name;
   std::string node_name;
   std::string type;
+  bool borrows{ false };         ///< True if the input only holds a shared handle to the output value.
+  std::uint64_t overflows{ 0 };  ///< Number of values rejected so far because the input was full.
+  bool fusable{ false };         ///< True for blocking inputs of depth one, see `NodeBase::fused`.
 };
 
 struct OutputSpecification {
@@ -46,9 +59,22 @@ public:
   using ClockT = concurrency::ClockT;
 
   static constexpr std::string_view MISSED_DEADLINE_WARNING = "Missed deadline";
+  /// Tag of the metric periodically recorded with the `NodeStatistics`.
+  static constexpr std::string_view NODE_STATISTICS_METRIC_TAG = "node_statistics";
+  /// Tag of the metric periodically recorded per traced path if tracing is enabled.
+  static constexpr std::string_view PATH_LATENCY_METRIC_TAG = "path_latency";
+  /// Period in which the statistics are published and their rolling window advances.
+  static constexpr auto STATISTICS_PERIOD = std::chrono::seconds{ 1 };
+
+  /// Latencies of the data originating from a node, measured when this node finished executing.
+  struct PathLatency {
+    std::uint64_t origin_node;
+    LatencyHistogram histogram;
+  };
 
   virtual ~NodeBase() = default;
-  [[nodiscard]] auto nodeName() const -> std::string;
+  /// Returns the name of the node, cached once the node has been placed on an engine.
+  [[nodiscard]] auto nodeName() const -> const std::string&;
   [[nodiscard]] virtual auto nodePeriod() -> std::chrono::nanoseconds = 0;
   virtual void removeOutputConnection(void* node) = 0;
 
@@ -69,8 +95,10 @@ public:
 
   [[nodiscard]] auto enginePrefix() const -> std::string;
 
+  /// Returns true if called from the context the node has been placed on.
   [[nodiscard]] auto runsOnEngine() const -> bool;
 
+  /// Returns the scheduler of the context the node has been placed on.
   [[nodiscard]] auto scheduler() const -> concurrency::Context::Scheduler;
 
   auto getStopToken() -> stdexec::inplace_stop_token;
@@ -105,9 +133,61 @@ public:
     return last_execution_duration_;
   }
 
+  /// Statistics as of their last publication, safe to call from any thread.
+  [[nodiscard]] auto statistics() const -> NodeStatistics;
+
+  /// Accounts a value rejected by one of the inputs of the node, called on the context of the node.
+  void recordInputOverflow() {
+    ++statistics_.input_overflows;
+  }
+
+  /// Id of the node derived from its name, stable across processes. Nodes of an engine sharing a name
+  /// get distinct ids, derived from the name and the order in which they got created.
+  [[nodiscard]] auto nodeId() const -> std::uint64_t {
+    return id_;
+  }
+
+  /// Trace of the oldest data consumed by the current execution.
+  [[nodiscard]] auto inputTrace() const -> const TraceContext& {
+    return input_trace_;
+  }
+
+  /// Age of the oldest data consumed by the current execution, zero if nothing traced got consumed.
+  [[nodiscard]] auto dataAge() const -> ClockT::duration;
+
+  /// Accounts data consumed by the current execution, used by inputs and nodes receiving data from
+  /// outside the engine.
+  void consumeTrace(const TraceContext& trace) {
+    input_trace_.merge(trace);
+  }
+
+  /// Trace attached to the values produced by the current execution.
+  [[nodiscard]] auto outputTrace() const -> TraceContext;
+
+  /// True if the node got fused with the node producing its only input, see
+  /// `NodeEngineConfig::fuse_linear_chains`. Fused nodes execute inline once triggered on their
+  /// context instead of being scheduled again.
+  [[nodiscard]] auto fused() const -> bool {
+    return fused_;
+  }
+
+  /// Latencies per origin of the consumed data.
+  /// \note Updated on the context of the node, only access it when the engine is not running.
+  [[nodiscard]] auto pathLatencies() const -> const std::vector<PathLatency>& {
+    return path_latencies_;
+  }
+
 protected:
   [[nodiscard]] virtual auto nodeName(const std::string& prefix) const -> std::string = 0;
+
+  /// Telemetry context of the node, computed once when the node is created to keep the execution
+  /// path free of allocations.
+  [[nodiscard]] auto telemetryContext() const -> const telemetry::Scope::Context& {
+    return telemetry_context_;
+  }
+
   auto operationStart(bool has_period) -> ClockT::time_point;
+  void operationTriggered();
   void operationEnd();
   void updateExecutionTime(std::chrono::nanoseconds duration);
   auto nextStartTime(bool has_period) -> ClockT::time_point;
@@ -116,19 +196,88 @@ private:
   friend class heph::conduit::NodeEngine;
   friend class heph::conduit::RemoteNodeHandler;
   friend class ExecutionStopWatch;
+
+  /// Caches the names, needs to be called once the node is fully constructed and placed on an engine.
+  void initializeNames();
+  [[nodiscard]] static auto hashName(std::string_view name) -> std::uint64_t;
+  void executionStarted();
+  /// Makes the statistics available to other threads and advances their rolling window.
+  void publishStatistics();
+  void recordPathLatency(ClockT::time_point now);
+  void exportPathLatencies();
+  /// Records the buffered timings as metrics, one per execution.
+  void exportTimings();
+
+  /// Timings of an execution, buffered to keep recording them out of the execution path.
+  struct TimingSample {
+    std::chrono::system_clock::time_point timestamp;
+    std::chrono::nanoseconds execute_duration;
+    std::chrono::nanoseconds tick_duration;
+    std::chrono::microseconds clock_drift;
+    std::chrono::microseconds period_drift;
+  };
+  /// Executions buffered at most before the timings get recorded ahead of the statistics period.
+  static constexpr std::size_t MAX_TIMING_SAMPLES = 1024;
+
   NodeEngine* engine_{ nullptr };
+  concurrency::Context* context_{ nullptr };
+  std::size_t context_index_{ 0 };
   std::chrono::nanoseconds last_execution_duration_{};
 
   std::chrono::steady_clock::time_point last_steady_;
   ClockT::time_point last_system_;
   ClockT::time_point start_time_;
+  ClockT::time_point scheduled_start_;
+  ClockT::time_point triggered_at_;
   std::size_t iteration_{ 0 };
+  bool fused_{ false };
+
+  // Statistics of the current and the previous period, only accessed on the context of the node.
+  NodeStatistics statistics_;
+  NodeStatistics previous_statistics_;
+  ClockT::time_point last_statistics_publish_;
+  mutable std::mutex published_statistics_mutex_;
+  NodeStatistics published_statistics_;
+
+  std::string name_;
+  // Name returned before the node got placed on an engine, see `nodeName`.
+  mutable std::string provisional_name_;
+  std::uint64_t id_{ 0 };
+  std::string metric_component_;
+  telemetry::Scope::Context telemetry_context_;
+  std::vector<TimingSample> timing_samples_;
+
+  bool tracing_{ false };
+  TraceContext input_trace_;
+  std::vector<PathLatency> path_latencies_;
 
   std::vector<std::function<void()>> input_registrations_;
   std::vector<std::function<InputSpecification()>> input_specs_;
   std::vector<std::function<OutputSpecification()>> output_specs_;
 };
 
+struct NodeScheduleT {};
+
+/// Continues a node on its context. Fused nodes triggered on their context continue inline, skipping
+/// the round trip through the ready queue of the context.
+template <typename ReceiverT>
+struct NodeScheduleTask {
+  NodeBase* node;
+  concurrency::Task<ReceiverT, concurrency::Context> task;
+
+  void start() noexcept {
+    if (!node->fused() || !node->runsOnEngine()) {
+      task.start();
+      return;
+    }
+    if (node->getStopToken().stop_requested()) {
+      task.setStopped();
+    } else {
+      task.setValue();
+    }
+  }
+};
+
 class ExecutionStopWatch {
 public:
   explicit ExecutionStopWatch(NodeBase* self);
@@ -144,3 +293,27 @@ private:
   std::chrono::high_resolution_clock::time_point start_;
 };
 }  // namespace heph::conduit::detail
+
+namespace heph::concurrency {
+template <>
+struct SenderExpressionImpl<heph::conduit::detail::NodeScheduleT> : DefaultSenderExpressionImpl {
+  static constexpr auto GET_COMPLETION_SIGNATURES = [](Ignore, Ignore = {}) noexcept {
+    return stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_error_t(std::exception_ptr),
+                                          stdexec::set_stopped_t()>{};
+  };
+
+  static constexpr auto GET_ATTRS = [](heph::conduit::detail::NodeBase* node) noexcept -> ContextEnv {
+    return { &node->scheduler().context() };
+  };
+
+  static constexpr auto GET_STATE = []<typename Sender, typename Receiver>(Sender&& sender,
+                                                                           Receiver& receiver) {
+    auto [_, node] = std::forward<Sender>(sender);
+    return heph::conduit::detail::NodeScheduleTask<std::decay_t<Receiver>>{
+      .node = node, .task = { &node->scheduler().context(), std::move(receiver) }
+    };
+  };
+
+  static constexpr auto START = [](auto& task, Ignore) noexcept { task.start(); };
+};
+}  // namespace heph::concurrency
@@ -5,26 +5,23 @@
 #pragma once
 
 #include <algorithm>
-#include <chrono>
-#include <cmath>
 #include <cstddef>
+#include <memory>
 #include <optional>
-#include <ranges>
 #include <string>
 #include <string_view>
-#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-#include <fmt/format.h>
-#include <fmt/ranges.h>
 #include <stdexec/execution.hpp>
 
+#include "hephaestus/concurrency/basic_sender.h"
 #include "hephaestus/concurrency/context.h"
 #include "hephaestus/concurrency/repeat_until.h"
+#include "hephaestus/conduit/detail/awaiter.h"
 #include "hephaestus/conduit/input.h"
-#include "hephaestus/telemetry/log/log.h"
+#include "hephaestus/conduit/trace_context.h"
 #include "hephaestus/utils/utils.h"
 
 namespace heph::conduit {
@@ -33,7 +30,33 @@ auto scheduler(NodeEngine& engine) -> concurrency::Context::Scheduler;
 }  // namespace heph::conduit
 namespace heph::conduit::detail {
 class NodeBase;
+class OutputConnections;
 
+struct OutputSlotWaitT {};
+template <typename ReceiverT>
+class SlotAwaiter;
+}  // namespace heph::conduit::detail
+
+// Sender waiting until the input an output is blocked on has space again
+namespace heph::concurrency {
+template <>
+struct SenderExpressionImpl<heph::conduit::detail::OutputSlotWaitT> : DefaultSenderExpressionImpl {
+  static constexpr auto GET_COMPLETION_SIGNATURES = [](Ignore, Ignore = {}) noexcept {
+    return stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>{};
+  };
+
+  static constexpr auto GET_STATE = []<typename Sender, typename Receiver>(Sender&& sender,
+                                                                           Receiver&& receiver) {
+    auto [_, self] = std::forward<Sender>(sender);
+    return heph::conduit::detail::SlotAwaiter<std::decay_t<Receiver>>{ self,
+                                                                       std::forward<Receiver>(receiver) };
+  };
+
+  static constexpr auto START = [](auto& awaiter, Ignore) { awaiter.start(); };
+};
+}  // namespace heph::concurrency
+
+namespace heph::conduit::detail {
 template <typename T>
 auto extractResult(T& t) -> T* {
   return &t;
@@ -48,20 +71,28 @@ auto extractResult(std::optional<T>& t) -> T* {
 
 class OutputConnections {
   struct InputEntry {
-    using SetValueT = InputState (*)(void*, void*);
+    using SetValueT = InputState (*)(void*, const void*, const TraceContext&);
+    using ShareValueT = InputState (*)(void*, const std::shared_ptr<const void>&, const TraceContext&);
     using NameT = std::string (*)(void*);
+    using AwaitSlotT = void (*)(void*, SlotAwaiterBase*);
     void* ptr;
     SetValueT set_value;
+    /// Set for inputs borrowing a `SharedValue`, nullptr for inputs taking ownership of a copy.
+    ShareValueT share_value;
     NameT name;
+    AwaitSlotT await_slot;
+    AwaitSlotT cancel_await_slot;
     detail::NodeBase* node;
     std::size_t generation;
+    /// Set once a delivery has been attempted in the current round.
+    bool attempted{ false };
   };
 
   using SchedulerT = concurrency::Context::Scheduler;
 
 public:
-  static constexpr std::string_view INPUT_OVERFLOW_WARNING =
-      "Delaying Output operation because receiving input would overflow";
+  /// Tag of the metric recorded whenever an input rejects a value and the output has to wait.
+  static constexpr std::string_view INPUT_OVERFLOW_METRIC_TAG = "input_overflow";
 
   OutputConnections(detail::NodeBase* node, std::string name);
 
@@ -74,16 +105,33 @@ public:
 
   template <typename Input>
   void registerInput(Input* input) {
+    using ValueT = typename Input::ValueT;
+    typename InputEntry::ShareValueT share_value = nullptr;
+    if constexpr (ISSHAREDVALUE<ValueT>) {
+      share_value = [](void* input_ptr, const std::shared_ptr<const void>& shared,
+                       const TraceContext& trace) {
+        return static_cast<Input*>(input_ptr)->setValue(
+            std::static_pointer_cast<const SharedValueElementT<ValueT>>(shared), trace);
+      };
+    }
     inputs_.emplace_back(
         input,
-        [](void* input_ptr, void* ptr) {
-          return static_cast<Input*>(input_ptr)->setValue(*static_cast<typename Input::ValueT*>(ptr));
+        [](void* input_ptr, const void* ptr, const TraceContext& trace) {
+          return static_cast<Input*>(input_ptr)->setValue(*static_cast<const ValueT*>(ptr), trace);
+        },
+        share_value, [](void* input_ptr) { return std::string{ static_cast<Input*>(input_ptr)->name() }; },
+        [](void* input_ptr, SlotAwaiterBase* awaiter) { static_cast<Input*>(input_ptr)->awaitSlot(awaiter); },
+        [](void* input_ptr, SlotAwaiterBase* awaiter) {
+          static_cast<Input*>(input_ptr)->cancelAwaitSlot(awaiter);
         },
-        [](void* input_ptr) { return std::string{ static_cast<Input*>(input_ptr)->name() }; }, input->node(),
-        generation_);
+        input->node(), generation_);
 
-    registerInputToEngine(input->rawName(), heph::utils::getTypeName<typename Input::ValueT>(),
-                          input->node());
+    registerInputToEngine(input->rawName(), heph::utils::getTypeName<ValueT>(), input->node(),
+                          ISSHAREDVALUE<ValueT>);
+  }
+
+  [[nodiscard]] auto hasConnections() const -> bool {
+    return !inputs_.empty();
   }
 
   void removeConnection(void* node) {
@@ -96,66 +144,121 @@ public:
     }
   }
 
+  /// Registers `awaiter` on the input the current propagation is blocked on. Returns false if the
+  /// propagation is not blocked.
+  auto awaitSlot(SlotAwaiterBase* awaiter) -> bool;
+  void cancelAwaitSlot(SlotAwaiterBase* awaiter);
+
 private:
-  void registerInputToEngine(std::string name, std::string type, detail::NodeBase* node);
+  void registerInputToEngine(std::string name, std::string type, detail::NodeBase* node, bool borrows);
+  [[nodiscard]] auto currentTrace() const -> TraceContext;
 
-  using ScheduleAfterResultT = std::decay_t<decltype(std::declval<SchedulerT>().scheduleAfter(
-      std::declval<std::chrono::milliseconds>()))>;
-  auto retryTimeout(NodeEngine& engine) -> ScheduleAfterResultT;
+  template <typename T>
+  auto propagateValue(T& result) -> bool;
+
+  /// Delivers the value to all pending inputs living on the current context and decides where the
+  /// next propagation step runs. Returns true once the value reached all inputs.
+  auto propagateToInputs(const void* value, bool share) -> bool;
+
+  using NextStepT = decltype(stdexec::continues_on(
+      heph::concurrency::makeSenderExpression<OutputSlotWaitT>(std::declval<OutputConnections*>()),
+      std::declval<SchedulerT>()));
+  auto nextStep(NodeEngine& engine) -> NextStepT;
+  void startNextRound(InputEntry& overflowed_entry);
 
 private:
   std::vector<InputEntry> inputs_;
+  // Holder of the current result, shared between all borrowing inputs until it is fully propagated.
+  std::shared_ptr<const void> shared_value_;
+  // Trace of the value currently being propagated.
+  TraceContext trace_;
   std::size_t generation_{ 0 };
-  std::size_t retry_{ 0 };
+  std::size_t overflow_count_{ 0 };
+  // Inputs are only ever set from the context their node is running on. Propagation hops to the
+  // context of the pending inputs, `nullptr` refers to the context of the producing node.
+  concurrency::Context* next_context_{ nullptr };
+  // Input on the current context which rejected the value, the next step waits until it has space.
+  InputEntry* blocked_entry_{ nullptr };
   detail::NodeBase* node_;
   std::string name_;
 };
 
+template <typename ReceiverT>
+class SlotAwaiter : public SlotAwaiterBase {
+  struct StopCallback {
+    void operator()() const noexcept {
+      self->handleStopped();
+    }
+    SlotAwaiter* self;
+  };
+  using ReceiverEnvT = stdexec::env_of_t<ReceiverT>;
+  using StopTokenT = stdexec::stop_token_of_t<ReceiverEnvT>;
+  using StopCallbackT = stdexec::stop_callback_for_t<StopTokenT, StopCallback>;
+
+public:
+  SlotAwaiter(OutputConnections* self, ReceiverT receiver) : self_{ self }, receiver_{ std::move(receiver) } {
+  }
+
+  ~SlotAwaiter() noexcept final {
+    if (enqueued_) {
+      self_->cancelAwaitSlot(this);
+    }
+  }
+
+  SlotAwaiter(const SlotAwaiter&) = delete;
+  SlotAwaiter(SlotAwaiter&&) = delete;
+  auto operator=(const SlotAwaiter&) -> SlotAwaiter& = delete;
+  auto operator=(SlotAwaiter&&) -> SlotAwaiter& = delete;
+
+  void start() {
+    auto stop_token = stdexec::get_stop_token(stdexec::get_env(receiver_));
+    // The stop callback would complete us inline, before we are linked to the input.
+    if (stop_token.stop_requested()) {
+      stdexec::set_stopped(std::move(receiver_));
+      return;
+    }
+    if (!self_->awaitSlot(this)) {
+      stdexec::set_value(std::move(receiver_));
+      return;
+    }
+    enqueued_ = true;
+    stop_callback_.emplace(stop_token, StopCallback{ this });
+  }
+
+  void slotAvailable() final {
+    enqueued_ = false;
+    stop_callback_.reset();
+    stdexec::set_value(std::move(receiver_));
+  }
+
+private:
+  void handleStopped() {
+    stop_callback_.reset();
+    if (enqueued_) {
+      enqueued_ = false;
+      self_->cancelAwaitSlot(this);
+    }
+    stdexec::set_stopped(std::move(receiver_));
+  }
+
+private:
+  OutputConnections* self_;
+  ReceiverT receiver_;
+  std::optional<StopCallbackT> stop_callback_;
+  bool enqueued_{ false };
+};
+
 inline auto OutputConnections::propagate(NodeEngine& engine) {
-  return stdexec::let_value([this, &engine]<typename... Ts>(Ts&&... ts) {
+  return stdexec::let_value([this, &engine]<typename... Ts>(Ts&... ts) {
     // If the continuation didn't get any parameters, the operator
     // return void, and we can move on ...
     // Otherwise, we attempt to set the result to connected inputs.
     if constexpr (sizeof...(Ts) == 1) {
-      auto args = std::make_tuple(std::forward<Ts>(ts)...);
-      return heph::concurrency::repeatUntil([this, &engine, args = std::move(args)]() {
-        return retryTimeout(engine) | stdexec::then([this, args = std::move(args)] {
-                 bool done = std::apply(
-                     [this]<typename T>(T result) {
-                       if (inputs_.empty()) {
-                         return true;
-                       }
-                       //  Extract result: In case of an optional without a value, we
-                       //  get a nullptr and return immediately without propagating
-                       //  anything.
-                       auto* result_ptr = extractResult(result);
-                       if (result_ptr == nullptr) {
-                         return true;
-                       }
-
-                       std::size_t propagated_count{ 0 };
-                       for (InputEntry& entry : inputs_) {
-                         if (entry.generation != generation_) {
-                           ++propagated_count;
-                           continue;
-                         }
-                         if (entry.set_value(entry.ptr, result_ptr) == InputState::OK) {
-                           ++propagated_count;
-                           ++entry.generation;
-                         }
-                       }
-                       if (propagated_count == inputs_.size()) {
-                         // Everything is propagated, now reset...
-                         generation_++;
-                         retry_ = 0;
-                         return true;
-                       }
-                       ++retry_;
-                       return false;
-                     },
-                     args);
-                 return done;
-               });
+      // The result is kept alive by let_value until propagation finished, we can refer to it
+      // while retrying instead of copying it for each attempt.
+      trace_ = currentTrace();
+      return heph::concurrency::repeatUntil([this, &engine, &ts...]() {
+        return nextStep(engine) | stdexec::then([this, &ts...] { return propagateValue(ts...); });
       });
     } else {
       (void)this;
@@ -165,23 +268,30 @@ inline auto OutputConnections::propagate(NodeEngine& engine) {
   });
 }
 
-inline auto OutputConnections::retryTimeout(NodeEngine& engine) -> ScheduleAfterResultT {
-  // TODO: find better way to timeout based on the inputs timing...
-  // Currently doing floor(retry^1.5)
-  static constexpr float EXP = 1.5f;
-  std::chrono::milliseconds timeout{ 0 };
-  if (retry_ > 0) {
-    timeout = std::chrono::milliseconds(
-        static_cast<std::chrono::milliseconds::rep>(std::floor(std::pow(static_cast<float>(retry_), EXP))));
-
-    auto remaining_inputs =
-        inputs_ |
-        std::views::filter([this](const InputEntry& entry) { return entry.generation <= generation_; }) |
-        std::views::transform([](InputEntry& entry) { return entry.name(entry.ptr); });
-
-    heph::log(heph::WARN, std::string(INPUT_OVERFLOW_WARNING), "output", name(), "inputs",
-              fmt::format("[{}]", fmt::join(remaining_inputs, ", ")), "retry", retry_, "delay", timeout);
+template <typename T>
+inline auto OutputConnections::propagateValue(T& result) -> bool {
+  if (inputs_.empty()) {
+    return true;
+  }
+  //  Extract result: In case of an optional without a value, we
+  //  get a nullptr and return immediately without propagating
+  //  anything.
+  auto* result_ptr = extractResult(result);
+  if (result_ptr == nullptr) {
+    return true;
+  }
+  using ValueT = std::remove_pointer_t<decltype(result_ptr)>;
+
+  if constexpr (!ISSHAREDVALUE<ValueT>) {
+    // The result is moved into the shared holder before the first input borrows it, owning inputs
+    // then copy from the holder.
+    if (shared_value_ == nullptr &&
+        std::ranges::any_of(inputs_, [](const InputEntry& entry) { return entry.share_value != nullptr; })) {
+      shared_value_ = std::shared_ptr<const ValueT>{ std::make_shared<ValueT>(std::move(*result_ptr)) };
+    }
+    return propagateToInputs(shared_value_ != nullptr ? shared_value_.get() : result_ptr, true);
+  } else {
+    return propagateToInputs(result_ptr, false);
   }
-  return heph::conduit::scheduler(engine).scheduleAfter(timeout);
 }
 }  // namespace heph::conduit::detail
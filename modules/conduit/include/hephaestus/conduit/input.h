@@ -6,6 +6,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
 
 namespace heph::conduit {
 enum struct RetrievalMethod : std::uint8_t {
@@ -32,4 +34,29 @@ enum struct InputState : std::uint8_t {
   OVERFLOW,
   // OVERWRITE,
 };
+
+/// Inputs declared with a value type of `SharedValue<T>` only borrow the result of the output they are
+/// connected to. The output places its result once into a ref-counted immutable holder and every
+/// borrowing input receives a handle to it, instead of a deep copy. Inputs of type `T` keep taking
+/// ownership of their own copy.
+template <typename T>
+using SharedValue = std::shared_ptr<const T>;
+
+namespace detail {
+template <typename T>
+struct SharedValueTraits : std::false_type {
+  using ElementT = T;
+};
+template <typename T>
+struct SharedValueTraits<std::shared_ptr<const T>> : std::true_type {
+  using ElementT = T;
+};
+
+template <typename T>
+static constexpr bool ISSHAREDVALUE = SharedValueTraits<std::decay_t<T>>::value;
+
+/// The type being produced by an output which can be connected to an input of type `T`.
+template <typename T>
+using SharedValueElementT = typename SharedValueTraits<std::decay_t<T>>::ElementT;
+}  // namespace detail
 }  // namespace heph::conduit
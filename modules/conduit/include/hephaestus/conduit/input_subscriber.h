@@ -41,7 +41,8 @@ public:
       auto stripped_name = input.name().substr(prefix.size());
       return fmt::format("{}/subscriber", stripped_name);
     }())
-    , node_(engine.createNode<Node>(this)) {
+    // Peeking into the input is only allowed from the context of its node.
+    , node_(engine.createNodeOn<Node>(engine.contextIndex(*input.node()), this)) {
   }
 
   auto output() -> NodeHandle<Node>& {
@@ -0,0 +1,90 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace heph::conduit {
+
+/// Histogram of durations with logarithmic buckets, bucket `i` counts durations below 2^i microseconds
+/// which didn't fit into the previous bucket. Adding samples never allocates, which makes it suitable
+/// for the execution path of nodes.
+class LatencyHistogram {
+public:
+  static constexpr std::size_t NUM_BUCKETS = 32;
+
+  void add(std::chrono::nanoseconds duration) {
+    const auto us = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+    const auto bucket = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(us)), NUM_BUCKETS - 1);
+    ++buckets_[bucket];
+    ++count_;
+    sum_ += duration;
+    max_ = std::max(max_, duration);
+  }
+
+  [[nodiscard]] auto count() const -> std::uint64_t {
+    return count_;
+  }
+
+  [[nodiscard]] auto max() const -> std::chrono::nanoseconds {
+    return max_;
+  }
+
+  [[nodiscard]] auto mean() const -> std::chrono::nanoseconds {
+    return count_ == 0 ? std::chrono::nanoseconds{ 0 } :
+                         sum_ / static_cast<std::chrono::nanoseconds::rep>(count_);
+  }
+
+  /// Returns an upper bound of the given percentile, `fraction` being in the range [0, 1]. The bound
+  /// is the upper edge of the bucket containing the percentile, clamped to the maximum sample.
+  [[nodiscard]] auto percentile(double fraction) const -> std::chrono::nanoseconds {
+    if (count_ == 0) {
+      return std::chrono::nanoseconds{ 0 };
+    }
+    const auto rank = std::max<std::uint64_t>(
+        static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(count_))), 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i != NUM_BUCKETS; ++i) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        const std::chrono::nanoseconds upper_edge = std::chrono::microseconds{ std::int64_t{ 1 } << i };
+        return std::min(upper_edge, max_);
+      }
+    }
+    return max_;
+  }
+
+  /// Adds the samples of `other`, e.g. to combine histograms of consecutive time windows.
+  void merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i != NUM_BUCKETS; ++i) {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  [[nodiscard]] auto buckets() const -> const std::array<std::uint64_t, NUM_BUCKETS>& {
+    return buckets_;
+  }
+
+  void reset() {
+    *this = LatencyHistogram{};
+  }
+
+private:
+  std::array<std::uint64_t, NUM_BUCKETS> buckets_{};
+  std::uint64_t count_{ 0 };
+  std::chrono::nanoseconds sum_{ 0 };
+  std::chrono::nanoseconds max_{ 0 };
+};
+}  // namespace heph::conduit
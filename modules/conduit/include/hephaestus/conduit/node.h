@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 
 #include <fmt/format.h>
@@ -15,6 +16,7 @@
 #include <stdexec/__detail/__sync_wait.hpp>
 #include <stdexec/execution.hpp>
 
+#include "hephaestus/concurrency/basic_sender.h"
 #include "hephaestus/conduit/detail/node_base.h"
 #include "hephaestus/conduit/detail/output_connections.h"
 #include "hephaestus/telemetry/log/scope.h"
@@ -70,6 +72,11 @@ public:
     implicit_output_->removeConnection(node);
   }
 
+  /// Returns true while any input is connected to the output of the node.
+  [[nodiscard]] auto hasOutputConnections() const -> bool {
+    return implicit_output_->hasConnections();
+  }
+
 private:
   [[nodiscard]] auto nodeName(const std::string& prefix) const -> std::string final;
 
@@ -78,7 +85,7 @@ private:
       detail::ExecutionStopWatch stop_watch{ this };
       static_assert(HAS_EXECUTE_ARG_PTR<Ts...> || HAS_EXECUTE_ARG<Ts...> || HAS_EXECUTE_NULLARY<Ts...>,
                     "No valid execute function available");
-      const telemetry::Scope scope{ enginePrefix(), nodeName("") };
+      const telemetry::Scope scope{ telemetryContext() };
       if constexpr (HAS_EXECUTE_ARG<Ts...>) {
         return OperationT::execute(operation(), std::forward<Ts>(ts)...);
       } else if constexpr (HAS_EXECUTE_ARG_PTR<Ts...>) {
@@ -92,7 +99,10 @@ private:
   auto operationTrigger() {
     auto period_trigger = [&](detail::NodeBase::ClockT::time_point start_at) {
       if constexpr (HAS_PERIOD) {
-        return heph::conduit::scheduler(engine()).scheduleAt(start_at);
+        // The deadline only matters for contexts ordering ready tasks by it.
+        const auto deadline =
+            start_at + std::chrono::duration_cast<detail::NodeBase::ClockT::duration>(nodePeriod());
+        return this->scheduler().scheduleAt(start_at, deadline);
       } else {
         return stdexec::just();
       }
@@ -112,14 +122,22 @@ private:
     };
     return stdexec::just() | stdexec::let_value([this, period_trigger, node_trigger] {
              auto start_at = operationStart(HAS_PERIOD);
-             return stdexec::when_all(period_trigger(start_at), node_trigger());
+             return stdexec::when_all(period_trigger(start_at), node_trigger()) |
+                    stdexec::let_value([this]<typename... Ts>(Ts&... ts) {
+                      operationTriggered();
+                      return stdexec::just(std::move(ts)...);
+                    });
            });
   }
 
   auto executeSender() {
     auto invoke_operation = invokeOperation();
 
-    auto trigger = stdexec::continues_on(operationTrigger(), heph::conduit::scheduler(engine()));
+    auto trigger = operationTrigger() | stdexec::let_value([this]<typename... Ts>(Ts&... ts) {
+                     return heph::concurrency::makeSenderExpression<detail::NodeScheduleT>(
+                                static_cast<detail::NodeBase*>(this)) |
+                            stdexec::let_value([&ts...] { return stdexec::just(std::move(ts)...); });
+                   });
     using TriggerT = decltype(trigger);
     using TriggerValuesVariantT = stdexec::__sync_wait::__sync_wait_with_variant_result_t<TriggerT>;
     // static_assert(std::variant_size_v<TriggerValuesVariantT> == 1);
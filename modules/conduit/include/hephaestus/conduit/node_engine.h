@@ -8,10 +8,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,44 +27,88 @@
 #include "hephaestus/conduit/detail/input_base.h"
 #include "hephaestus/conduit/detail/node_base.h"
 #include "hephaestus/conduit/detail/output_connections.h"
+#include "hephaestus/conduit/latency_histogram.h"
 #include "hephaestus/conduit/node_handle.h"
+#include "hephaestus/conduit/node_statistics.h"
 #include "hephaestus/conduit/remote_node_handler.h"
+#include "hephaestus/error_handling/panic.h"
 #include "hephaestus/net/endpoint.h"
-#include "hephaestus/telemetry/log/log.h"
+#include "hephaestus/net/shared_memory_ring.h"
 
 namespace heph::conduit {
 struct NodeEngineConfig {
   heph::concurrency::ContextConfig context_config;
   std::string prefix;
   std::uint32_t number_of_threads{ 1 };
+  /// Number of contexts executing nodes, each running on its own thread. The first context runs on
+  /// the thread calling `NodeEngine::run`.
+  std::uint32_t number_of_contexts{ 1 };
   std::vector<heph::net::Endpoint> endpoints;
+  /// Capacity of the shared memory ring each IPC connection creates once it carries large payloads,
+  /// zero sends all payloads through the socket.
+  std::size_t shared_memory_ring_capacity{ heph::net::SharedMemoryRing::DEFAULT_CAPACITY };
+  /// Attaches a `TraceContext` to propagated values and records the latencies per path, see
+  /// `NodeEngine::getPathLatencies`.
+  bool enable_tracing{ false };
+  /// Fuses linear chains of nodes: a node triggered by a single blocking input of depth one, which is
+  /// the only connection of the node producing it, executes inline on the shared context instead of
+  /// being scheduled again. Names, statistics and the graph are unaffected.
+  bool fuse_linear_chains{ false };
+};
+
+/// Latency between the production of data by `origin` and the end of the execution of `node`
+/// having consumed it.
+struct PathLatency {
+  std::string origin;
+  std::string node;
+  LatencyHistogram histogram;
 };
 
 class NodeEngine {
 public:
+  /// Context running remote connections and nodes which are not explicitly placed elsewhere.
+  static constexpr std::size_t MAIN_CONTEXT = 0;
+
   explicit NodeEngine(const NodeEngineConfig& config);
 
   void run();
   void requestStop();
 
   auto getStopToken() {
-    return context_.getStopToken();
+    return mainContext().getStopToken();
   }
 
   auto scheduler() {
-    return context_.scheduler();
+    return mainContext().scheduler();
+  }
+
+  /// Returns the scheduler of the context with the given index.
+  auto scheduler(std::size_t context_index) {
+    return contexts_.at(context_index)->scheduler();
+  }
+
+  [[nodiscard]] auto numberOfContexts() const -> std::size_t {
+    return contexts_.size();
   }
 
+  /// Returns the index of the context the node has been placed on.
+  [[nodiscard]] auto contextIndex(const detail::NodeBase& node) const -> std::size_t;
+
   auto isCurrent() -> bool {
-    return context_.isCurrent();
+    return mainContext().isCurrent();
   }
 
   auto poolScheduler() {
     return pool_.get_scheduler();
   }
 
+  /// Number of threads of the pool, see `parallelFor` to spread work across them.
+  [[nodiscard]] auto poolParallelism() const -> std::size_t {
+    return pool_.available_parallelism();
+  }
+
   auto elapsed() {
-    return context_.elapsed();
+    return mainContext().elapsed();
   }
 
   auto prefix() const -> std::string {
@@ -70,9 +117,19 @@ public:
 
   auto endpoints() const -> std::vector<heph::net::Endpoint>;
 
+  [[nodiscard]] auto sharedMemoryRingCapacity() const -> std::size_t {
+    return shared_memory_ring_capacity_;
+  }
+
+  /// Creates a node on the context with the least number of nodes.
   template <typename OperatorT, typename... Ts>
   auto createNode(Ts&&... ts) -> NodeHandle<OperatorT>;
 
+  /// Creates a node pinned to the context with the given index. Nodes exchanging data at high rates
+  /// should share a context to avoid cross thread hand-overs.
+  template <typename OperatorT, typename... Ts>
+  auto createNodeOn(std::size_t context_index, Ts&&... ts) -> NodeHandle<OperatorT>;
+
   template <typename Output>
   void registerOutput(Output& output);
   template <typename Node>
@@ -83,9 +140,30 @@ public:
   }
 
   void addConnectionSpecification();
-  [[nodiscard]] auto getDotGraph() const -> std::string;
+  /// Returns the graph in dot format. With `annotate_statistics`, nodes are labeled with their
+  /// `NodeStatistics` and edges with the overflows of the input.
+  [[nodiscard]] auto getDotGraph(bool annotate_statistics = false) const -> std::string;
+
+  /// Returns the statistics of all nodes by node id, as of their last publication.
+  [[nodiscard]] auto getNodeStatistics() const -> std::unordered_map<std::uint64_t, NodeStatistics>;
+
+  /// Returns the latencies of all traced paths, empty if tracing is disabled.
+  /// \note The histograms are updated while nodes are executing, call it once the engine stopped.
+  [[nodiscard]] auto getPathLatencies() const -> std::vector<PathLatency>;
 
 private:
+  auto mainContext() -> heph::concurrency::Context& {
+    return *contexts_[MAIN_CONTEXT];
+  }
+  [[nodiscard]] auto leastLoadedContext() const -> std::size_t;
+  /// Derives another id for nodes sharing their name with nodes created earlier.
+  void makeNodeIdUnique(detail::NodeBase& node);
+  void runContext(heph::concurrency::Context& context, const std::function<void()>& on_start);
+  void setException(std::exception_ptr exception);
+  void requestStopContexts();
+  /// Marks the nodes eligible for fusing with their producer, see `NodeEngineConfig::fuse_linear_chains`.
+  void fuseLinearChains();
+
   auto uponError();
   template <typename Node>
   auto uponStopped(Node* node);
@@ -102,17 +180,23 @@ private:
     connection_specs_.push_back(std::move(spec));
   }
 
-private:  // Optimal fields order: pool_, exception_, scope_, context_
+private:  // Optimal fields order: pool_, exception_, exception_mutex_, scope_, contexts_
   friend detail::OutputConnections;
 
   exec::static_thread_pool pool_;
   std::exception_ptr exception_;
+  std::mutex exception_mutex_;
   exec::async_scope scope_;
-  heph::concurrency::Context context_{ {} };
+  std::vector<std::unique_ptr<heph::concurrency::Context>> contexts_;
   std::string prefix_;
   std::vector<heph::net::Endpoint> endpoints_;
+  std::size_t shared_memory_ring_capacity_;
+  bool tracing_;
+  bool fuse_linear_chains_;
 
+  mutable std::mutex nodes_mutex_;
   std::vector<std::unique_ptr<detail::NodeBase>> nodes_;
+  std::vector<std::size_t> nodes_per_context_;
 
   RemoteNodeHandler remote_node_handler_;
 
@@ -128,6 +212,14 @@ void registerInput(NodeEngine& engine, InputT* input) {
 
 template <typename OperatorT, typename... Ts>
 inline auto NodeEngine::createNode(Ts&&... ts) -> NodeHandle<OperatorT> {
+  return createNodeOn<OperatorT>(leastLoadedContext(), std::forward<Ts>(ts)...);
+}
+
+template <typename OperatorT, typename... Ts>
+inline auto NodeEngine::createNodeOn(std::size_t context_index, Ts&&... ts) -> NodeHandle<OperatorT> {
+  if (context_index >= contexts_.size()) {
+    panic("Context index {} out of range, engine has {} contexts", context_index, contexts_.size());
+  }
   std::unique_ptr<OperatorT> node_ptr;
   if constexpr (std::is_constructible_v<OperatorT, NodeEngine&>) {
     node_ptr = std::make_unique<OperatorT>(*this);
@@ -135,7 +227,13 @@ inline auto NodeEngine::createNode(Ts&&... ts) -> NodeHandle<OperatorT> {
     node_ptr = std::make_unique<OperatorT>();
   }
   auto* node = node_ptr.get();
-  nodes_.emplace_back(std::move(node_ptr));
+  node->context_ = contexts_[context_index].get();
+  node->context_index_ = context_index;
+  {
+    const std::scoped_lock lock{ nodes_mutex_ };
+    nodes_.emplace_back(std::move(node_ptr));
+    ++nodes_per_context_[context_index];
+  }
   using OperationDataT = std::decay_t<decltype(node->data_)>::value_type;
   if constexpr (std::is_constructible_v<OperationDataT, NodeEngine&, Ts...>) {
     node->data_.emplace(*this, std::forward<Ts>(ts)...);
@@ -149,11 +247,18 @@ inline auto NodeEngine::createNode(Ts&&... ts) -> NodeHandle<OperatorT> {
   //  2. The name might only be fully valid after the node is fully constructed.
   node->implicit_output_.emplace(node, "output");
   node->engine_ = this;
+  node->tracing_ = tracing_;
+  node->initializeNames();
+  makeNodeIdUnique(*node);
   node->registerInputs();
 
   registerImplicitOutput(*node);
 
-  scope_.spawn(createNodeRunner(*node));
+  if (context_index == MAIN_CONTEXT) {
+    scope_.spawn(createNodeRunner(*node));
+  } else {
+    scope_.spawn(stdexec::starts_on(node->scheduler(), createNodeRunner(*node)));
+  }
   return NodeHandle{ node };
 }
 
@@ -170,32 +275,25 @@ inline void NodeEngine::registerImplicitOutput(Node& node) {
 inline auto NodeEngine::uponError() {
   return stdexec::upon_error([&]<typename Error>(Error error) noexcept {
     if constexpr (std::is_same_v<std::exception_ptr, std::decay_t<Error>>) {
-      if (exception_) {
-        try {
-          std::rethrow_exception(exception_);
-        } catch (std::exception& exception) {
-          heph::log(heph::ERROR, "Overriding previous exception", "exception", exception.what());
-        } catch (...) {
-          heph::log(heph::ERROR, "Overriding previous exception", "exception", "unknown");
-        }
-      }
-      exception_ = std::move(error);
+      setException(std::move(error));
     } else {
-      exception_ = std::make_exception_ptr(std::runtime_error("Unknown error"));
+      setException(std::make_exception_ptr(std::runtime_error("Unknown error")));
     }
-    context_.requestStop();
+    requestStopContexts();
   });
 }
 
 template <typename Node>
 inline auto NodeEngine::uponStopped(Node* node) {
   return stdexec::upon_stopped([this, node] {
-    if (context_.stopRequested()) {
+    if (node->scheduler().context().stopRequested()) {
       return;
     }
+    const std::scoped_lock lock{ nodes_mutex_ };
     auto it = std::ranges::find_if(nodes_, [node](auto& other) { return other.get() == node; });
     if (it != nodes_.end()) {
       auto node_ptr = std::move(*it);
+      --nodes_per_context_[node_ptr->context_index_];
       // Remove connected inputs...
       nodes_.erase(it);
       for (it = nodes_.begin(); it != nodes_.end(); ++it) {
@@ -207,8 +305,9 @@ inline auto NodeEngine::uponStopped(Node* node) {
 
 template <typename Node>
 inline auto NodeEngine::createNodeRunner(Node& node) {
-  auto runner = heph::concurrency::repeatUntil([&node, this] {
-                  return node.triggerExecute() | stdexec::then([this] { return context_.stopRequested(); });
+  auto runner = heph::concurrency::repeatUntil([&node] {
+                  return node.triggerExecute() |
+                         stdexec::then([&node] { return node.scheduler().context().stopRequested(); });
                 }) |
                 uponError() | uponStopped(&node);
   return std::move(runner);
@@ -0,0 +1,33 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <cstdint>
+
+#include "hephaestus/conduit/latency_histogram.h"
+
+namespace heph::conduit {
+
+/// Execution statistics of a node. The histograms cover a rolling window of one to two
+/// `NodeBase::STATISTICS_PERIOD`, the counters accumulate since the node got created.
+struct NodeStatistics {
+  /// Duration of the execute function.
+  LatencyHistogram execution_time;
+  /// Delay between the trigger completing and the execution starting on the context of the node.
+  LatencyHistogram start_latency;
+  /// Delay between the scheduled and the actual start of the execution, only set for periodic nodes.
+  LatencyHistogram period_jitter;
+  /// Time the execution finished past its deadline, the start of the next period. Executions in time
+  /// count as zero, only set for periodic nodes.
+  LatencyHistogram lateness;
+
+  std::uint64_t executions{ 0 };
+  std::uint64_t deadline_misses{ 0 };
+  /// Number of executions finishing past their deadline.
+  std::uint64_t late_executions{ 0 };
+  /// Number of values rejected by the inputs of the node because they were full.
+  std::uint64_t input_overflows{ 0 };
+};
+}  // namespace heph::conduit
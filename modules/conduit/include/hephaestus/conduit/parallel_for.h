@@ -0,0 +1,78 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+#include <boost/container/static_vector.hpp>
+#include <stdexec/execution.hpp>
+
+#include "hephaestus/concurrency/when_all_range.h"
+#include "hephaestus/conduit/detail/node_base.h"
+#include "hephaestus/conduit/node_engine.h"
+
+namespace heph::conduit {
+
+struct ParallelForOptions {
+  /// Smallest number of indices processed by a chunk, keeps cheap workloads from being dominated by
+  /// the overhead of handing chunks to the pool.
+  std::size_t min_chunk_size{ 1 };
+  /// Number of chunks per thread of the pool, more chunks balance uneven workloads better.
+  std::size_t chunks_per_thread{ 4 };
+};
+
+/// Upper bound of the number of chunks a workload gets split into.
+inline constexpr std::size_t PARALLEL_FOR_MAX_CHUNKS = 64;
+
+namespace detail {
+/// Number of chunks to split `size` indices into for a pool with `parallelism` threads.
+[[nodiscard]] auto parallelForChunks(std::size_t size, std::size_t parallelism,
+                                     const ParallelForOptions& options) -> std::size_t;
+}  // namespace detail
+
+/// Returns a sender calling `f(begin, end)` for consecutive chunks of the indices [0, `size`) on the
+/// thread pool of the engine, completing on the context of `node` once all chunks got processed.
+/// Meant to be returned from the `execute` function of nodes with heavy workloads, e.g. per point
+/// processing of a scan, without blocking their context:
+///
+///   static auto execute(Filter& self, Scan scan) {
+///     auto result = std::make_shared<Scan>(std::move(scan));
+///     return parallelFor(self, result->points.size(),
+///                        [result](std::size_t begin, std::size_t end) { filter(*result, begin, end); }) |
+///            stdexec::then([result] { return std::move(*result); });
+///   }
+///
+/// Chunks run concurrently, `f` must only write to data not shared between chunks. Chunks not
+/// started yet are skipped once the engine stops and the sender completes stopped. Exceptions
+/// thrown by `f` complete the sender with an error.
+template <typename F>
+  requires std::invocable<F&, std::size_t, std::size_t>
+[[nodiscard]] auto parallelFor(detail::NodeBase& node, std::size_t size, F f,
+                               ParallelForOptions options = {}) {
+  return stdexec::just() |
+         stdexec::let_value([&node, size, f = std::move(f), options]() mutable {
+           auto pool = node.engine().poolScheduler();
+           auto stop_token = node.getStopToken();
+           auto chunk = [pool, stop_token, f = &f](std::size_t begin, std::size_t end) {
+             return stdexec::schedule(pool) | stdexec::then([stop_token, f, begin, end] {
+                      if (!stop_token.stop_requested()) {
+                        (*f)(begin, end);
+                      }
+                    });
+           };
+
+           const auto num_chunks =
+               detail::parallelForChunks(size, node.engine().poolParallelism(), options);
+           boost::container::static_vector<decltype(chunk(0, 0)), PARALLEL_FOR_MAX_CHUNKS> chunks;
+           for (std::size_t i = 0; i != num_chunks; ++i) {
+             chunks.push_back(chunk(size * i / num_chunks, size * (i + 1) / num_chunks));
+           }
+           return concurrency::whenAllRange<PARALLEL_FOR_MAX_CHUNKS>(std::move(chunks));
+         }) |
+         stdexec::continues_on(node.scheduler());
+}
+}  // namespace heph::conduit
@@ -33,7 +33,7 @@ public:
   }
 
   auto getValue() -> std::optional<T> {
-    return this->buffer_.pop();
+    return this->popValue();
   }
 
   template <typename Receiver, bool Peek>
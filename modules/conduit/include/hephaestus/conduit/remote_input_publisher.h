@@ -5,10 +5,11 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <optional>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include <exec/task.hpp>
 #include <fmt/format.h>
@@ -30,18 +31,22 @@ namespace internal {
 class SetRemoteInputOperator {
 public:
   explicit SetRemoteInputOperator(heph::concurrency::Context* context, heph::net::Endpoint endpoint,
-                                  std::string name, bool reliable)
+                                  std::string name, bool reliable, std::uint16_t window, bool datagram,
+                                  std::size_t shared_memory_ring_capacity)
     : context_(context)
     , endpoint_(std::move(endpoint))
     , name_(std::move(name))
-    , type_{ .type = RemoteNodeType::INPUT, .reliable = reliable } {
+    , type_{ .type = RemoteNodeType::INPUT, .reliable = reliable, .window = window, .datagram = datagram }
+    , writer_(shared_memory_ring_capacity)
+    , window_(window) {
+    internal::checkDatagramType(endpoint_, type_);
   }
 
   [[nodiscard]] auto name() const {
     return fmt::format("{}/{}", endpoint_, name_);
   }
 
-  auto execute(std::vector<std::byte> msg, std::string* type_info) -> exec::task<bool>;
+  auto execute(TracedMessage msg, std::string* type_info) -> exec::task<bool>;
 
 private:
   heph::concurrency::Context* context_;
@@ -50,6 +55,14 @@ private:
   std::string name_;
   std::optional<std::string> last_error_;
   RemoteNodeType type_;
+  internal::FrameWriter writer_;
+  internal::AckWindow window_;
+  std::optional<heph::net::Socket> datagram_socket_;
+  internal::DatagramWriter datagram_writer_;
+  // Messages of a reliable connection which were not acknowledged yet, oldest first. They are sent
+  // again after reconnecting, the first `in_flight_` of them were sent on the current connection.
+  std::deque<TracedMessage> unacked_;
+  std::size_t in_flight_{ 0 };
 };
 
 template <typename T, typename InputPolicyT>
@@ -66,18 +79,22 @@ struct SetRemoteInput : Node<SetRemoteInput<T, InputPolicyT>, SetRemoteInputOper
   }
 
   static auto execute(SetRemoteInput& self, const T& t) {
-    return self.data().execute(heph::serdes::serialize(t), &self.type_info);
+    return self.data().execute(serializeTraced(t, self.outputTrace()), &self.type_info);
   }
 };
 }  // namespace internal
 
+/// Sets a remote input. Reliable connections deliver values at least once: values which were sent but
+/// not acknowledged when the connection got lost are sent again after reconnecting, the remote input
+/// receives them twice if only the acknowledgement got lost.
 template <typename T, typename InputPolicyT = InputPolicy<>>
 class RemoteInputPublisher {
 public:
   explicit RemoteInputPublisher(NodeEngine& engine, heph::net::Endpoint endpoint, std::string name,
-                                bool reliable = true)
-    : set_remote_input_(engine.createNode<internal::SetRemoteInput<T, InputPolicyT>>(
-          &engine.scheduler().context(), std::move(endpoint), std::move(name), reliable)) {
+                                bool reliable = true, std::uint16_t window = 1, bool datagram = false)
+    : set_remote_input_(engine.createNodeOn<internal::SetRemoteInput<T, InputPolicyT>>(
+          NodeEngine::MAIN_CONTEXT, &engine.scheduler().context(), std::move(endpoint), std::move(name),
+          reliable, window, datagram, engine.sharedMemoryRingCapacity())) {
   }
 
   template <typename Output>
@@ -30,7 +30,7 @@ namespace heph::conduit {
 class RemoteNodeHandler {
 public:
   RemoteNodeHandler(concurrency::Context& context, const std::vector<heph::net::Endpoint>& endpoints,
-                    std::exception_ptr& exception);
+                    std::exception_ptr& exception, std::size_t shared_memory_ring_capacity);
 
   ~RemoteNodeHandler();
 
@@ -53,28 +53,52 @@ private:
   auto acceptClients(std::size_t index) -> exec::task<void>;
   auto handleClient(heph::net::Socket client, RemoteNodeType type) -> exec::task<void>;
 
-  template <typename T, typename Engine, typename Node>
-  auto createPublisherNode(Engine& engine, Node& node, heph::net::Socket socket, std::string name,
-                           bool reliable) {
-    auto publisher = engine.template createNode<RemoteOutputPublisherNode<T>>(std::move(socket),
-                                                                              std::move(name), reliable);
-    publisher->input.connectTo(node);
+  /// Connects a publisher for the client to the serializer of the output, creating the serializer
+  /// for the first client. The serializer is kept once created, but skips serialization while no
+  /// client is connected.
+  template <typename T, typename Engine, typename Output>
+  auto createPublisherNode(Engine& engine, Output& output, RemoteOutputSerializerNode<T>*& serializer,
+                           heph::net::Socket socket, std::string name, RemoteNodeType type) {
+    if (serializer == nullptr) {
+      serializer = &*engine.template createNode<RemoteOutputSerializerNode<T>>(name);
+      serializer->input.connectTo(output);
+    }
+    // Remote nodes share the context of the connection they are serving.
+    if (type.reliable) {
+      auto publisher = engine.template createNodeOn<RemoteOutputPublisherNode<ReliablePublisherPolicy>>(
+          Engine::MAIN_CONTEXT, std::move(socket), std::move(name), type, shared_memory_ring_capacity_);
+      publisher->input.connectTo(*serializer);
+    } else {
+      auto publisher = engine.template createNodeOn<RemoteOutputPublisherNode<UnreliablePublisherPolicy>>(
+          Engine::MAIN_CONTEXT, std::move(socket), std::move(name), type, shared_memory_ring_capacity_);
+      publisher->input.connectTo(*serializer);
+    }
+  }
+
+  template <typename T, typename Engine, typename Output>
+  auto publisherFactory(Engine& engine, Output& output, std::string name) {
+    return [this, &engine, &output, name = std::move(name),
+            serializer = static_cast<RemoteOutputSerializerNode<T>*>(nullptr)](heph::net::Socket socket,
+                                                                               RemoteNodeType type) mutable {
+      createPublisherNode<T>(engine, output, serializer, std::move(socket), name, type);
+    };
   }
 
   template <typename T, typename Engine, typename InputT>
-  auto createSubscriberNode(Engine& engine, InputT* input, heph::net::Socket socket, bool reliable) {
-    auto subscriber =
-        engine.template createNode<RemoteInputSubscriber<T>>(std::move(socket), input->name(), reliable);
+  auto createSubscriberNode(Engine& engine, InputT* input, heph::net::Socket socket, RemoteNodeType type) {
+    auto subscriber = engine.template createNodeOn<RemoteInputSubscriber<T>>(
+        Engine::MAIN_CONTEXT, std::move(socket), input->name(), type);
     input->connectTo(subscriber);
   }
 
 private:
   struct RegistryEntry {
     std::string type_info;
-    heph::UniqueFunction<void(heph::net::Socket, bool)> factory;
+    heph::UniqueFunction<void(heph::net::Socket, RemoteNodeType)> factory;
   };
 
   std::exception_ptr& exception_;
+  std::size_t shared_memory_ring_capacity_;
   exec::async_scope scope_;
 
   std::vector<heph::net::Acceptor> acceptors_;
@@ -105,21 +129,12 @@ void RemoteNodeHandler::registerOutput(Engine& engine, Output& output, std::stri
   RegistryEntry entry;
   if constexpr (detail::ISOPTIONAL<ResultT>) {
     using ValueT = typename ResultT::value_type;
-    entry =
-        RegistryEntry{ .type_info = heph::serdes::getSerializedTypeInfo<ValueT>().toJson(),
-                       .factory =
-                           [this, &engine, &output, name](heph::net::Socket socket, bool reliable) {
-                             createPublisherNode<ValueT>(engine, output, std::move(socket), name, reliable);
-                           }
-
-        };
+    entry = RegistryEntry{ .type_info = heph::serdes::getSerializedTypeInfo<ValueT>().toJson(),
+                           .factory = publisherFactory<ValueT>(engine, output, name) };
   } else {
     if constexpr (!std::is_same_v<void, ResultT>) {
-      entry =
-          RegistryEntry{ .type_info = heph::serdes::getSerializedTypeInfo<ResultT>().toJson(),
-                         .factory = [this, &engine, &output, name](heph::net::Socket socket, bool reliable) {
-                           createPublisherNode<ResultT>(engine, output, std::move(socket), name, reliable);
-                         } };
+      entry = RegistryEntry{ .type_info = heph::serdes::getSerializedTypeInfo<ResultT>().toJson(),
+                             .factory = publisherFactory<ResultT>(engine, output, name) };
     }
     client_handlers_.emplace(name, std::move(entry));
   }
@@ -127,12 +142,13 @@ void RemoteNodeHandler::registerOutput(Engine& engine, Output& output, std::stri
 
 template <typename Engine, typename InputT>
 void RemoteNodeHandler::registerInput(Engine& engine, InputT* input) {
-  using ValueT = typename InputT::ValueT;
+  // Borrowing inputs are fed by a subscriber producing the plain element type.
+  using ValueT = detail::SharedValueElementT<typename InputT::ValueT>;
   client_handlers_.emplace(
       input->name(),
       RegistryEntry{ .type_info = heph::serdes::getSerializedTypeInfo<ValueT>().toJson(),
-                     .factory = [this, &engine, input](heph::net::Socket socket, bool reliable) {
-                       createSubscriberNode<ValueT>(engine, input, std::move(socket), reliable);
+                     .factory = [this, &engine, input](heph::net::Socket socket, RemoteNodeType type) {
+                       createSubscriberNode<ValueT>(engine, input, std::move(socket), type);
                      } });
 }
 }  // namespace heph::conduit
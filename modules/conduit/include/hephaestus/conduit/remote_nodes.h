@@ -4,10 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <exception>
-#include <limits>
 #include <memory_resource>
 #include <optional>
 #include <span>
@@ -19,18 +23,22 @@
 #include <vector>
 
 #include <exec/task.hpp>
+#include <exec/when_any.hpp>
 #include <fmt/format.h>
 #include <stdexec/execution.hpp>
+#include <sys/socket.h>
 
 #include "hephaestus/concurrency/context.h"
 #include "hephaestus/conduit/input.h"
 #include "hephaestus/conduit/node.h"
 #include "hephaestus/conduit/queued_input.h"
+#include "hephaestus/conduit/trace_context.h"
 #include "hephaestus/error_handling/panic.h"
 #include "hephaestus/net/connect.h"
 #include "hephaestus/net/endpoint.h"
 #include "hephaestus/net/recv.h"
 #include "hephaestus/net/send.h"
+#include "hephaestus/net/shared_memory_ring.h"
 #include "hephaestus/net/socket.h"
 #include "hephaestus/serdes/serdes.h"
 #include "hephaestus/telemetry/log/log.h"
@@ -43,40 +51,354 @@ struct RemoteNodeType {
 
   std::uint8_t type{ INPUT };
   bool reliable{ false };
+  /// Number of messages a reliable connection may have in flight without being acknowledged.
+  std::uint16_t window{ 1 };
+  /// Values of unreliable connections over IP are exchanged as UDP datagrams, the stream connection
+  /// is only kept to negotiate the datagram sockets and to notice lost peers.
+  bool datagram{ false };
 };
 
 inline constexpr std::string_view CONNECT_SUCCESS = "success";
 
 namespace internal {
+/// Messages are framed by their size, followed by the payload.
+using FrameSizeT = std::uint64_t;
+
+/// Frames flagged as shared memory frames carry the position and size of their payload in a shared
+/// memory ring instead of the payload itself. The ring is announced by a frame carrying its name.
+/// Both only appear on IPC connections, see `FrameWriter`.
+inline constexpr FrameSizeT SHARED_MEMORY_FRAME = FrameSizeT{ 1 } << 63U;
+inline constexpr FrameSizeT SHARED_MEMORY_ANNOUNCEMENT = FrameSizeT{ 1 } << 62U;
+inline constexpr FrameSizeT FRAME_FLAGS = SHARED_MEMORY_FRAME | SHARED_MEMORY_ANNOUNCEMENT;
+/// Position and size of a payload in the shared memory ring.
+using SharedMemoryDescriptorT = std::array<std::uint64_t, 2>;
+/// Frames are only accepted up to this size, a corrupt or hostile peer could make readers allocate
+/// arbitrarily large buffers otherwise. Larger frames fail the connection.
+inline constexpr FrameSizeT MAX_FRAME_SIZE = FrameSizeT{ 1 } << 30U;
+
+/// Throws `std::system_error` with `EMSGSIZE` for frames above `MAX_FRAME_SIZE`. The size comes from
+/// the peer, only the connection is dropped.
+inline void checkFrameSize(FrameSizeT size) {
+  if (size > MAX_FRAME_SIZE) {
+    throw std::system_error(EMSGSIZE, std::system_category(),
+                            fmt::format("Frame of {} bytes exceeds the maximum of {} bytes", size,
+                                        MAX_FRAME_SIZE));
+  }
+}
+
+/// Every serialized value is preceded by its trace: origin in microseconds since epoch, origin node
+/// and hops. The header is sent even if tracing is disabled to keep the wire format independent of
+/// the engine configuration. Like the rest of the framing, it is in host byte order: both ends of a
+/// connection need to share it.
+inline constexpr std::size_t TRACE_HEADER_SIZE =
+    sizeof(std::int64_t) + sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+/// Serialized value and its trace header, kept apart to send both without moving the payload.
+struct TracedMessage {
+  std::array<std::byte, TRACE_HEADER_SIZE> header{};
+  std::vector<std::byte> payload;
+  /// Position among the messages serialized for an output, not sent. Lets publishers notice values
+  /// dropped while their client was behind.
+  std::uint64_t sequence{ 0 };
+};
+
+template <typename T>
+auto serializeTraced(const T& value, const TraceContext& trace) -> TracedMessage {
+  const auto origin =
+      std::chrono::duration_cast<std::chrono::microseconds>(trace.origin.time_since_epoch()).count();
+  TracedMessage msg{ .header = {}, .payload = heph::serdes::serialize(value) };
+  std::memcpy(msg.header.data(), &origin, sizeof(origin));
+  std::memcpy(msg.header.data() + sizeof(origin), &trace.origin_node, sizeof(trace.origin_node));
+  std::memcpy(msg.header.data() + sizeof(origin) + sizeof(trace.origin_node), &trace.hops,
+              sizeof(trace.hops));
+  return msg;
+}
+
+/// Returns `std::nullopt` without touching `value` if the message is too short to carry the trace
+/// header. The message comes from the network, the caller drops it.
+template <typename T>
+auto deserializeTraced(std::span<const std::byte> msg, T& value) -> std::optional<TraceContext> {
+  if (msg.size() < TRACE_HEADER_SIZE) {
+    return std::nullopt;
+  }
+  std::int64_t origin{ 0 };
+  TraceContext trace;
+  std::memcpy(&origin, msg.data(), sizeof(origin));
+  std::memcpy(&trace.origin_node, msg.data() + sizeof(origin), sizeof(trace.origin_node));
+  std::memcpy(&trace.hops, msg.data() + sizeof(origin) + sizeof(trace.origin_node), sizeof(trace.hops));
+  trace.origin = TraceContext::ClockT::time_point{ std::chrono::microseconds{ origin } };
+
+  heph::serdes::deserialize(msg.subspan(TRACE_HEADER_SIZE), value);
+  return trace;
+}
+
+/// Buffers making up a message, sent back to back.
+template <typename Container>
+auto messageBuffers(const Container& message) -> std::array<std::span<const std::byte>, 1> {
+  return { std::as_bytes(std::span{ message }) };
+}
+
+inline auto messageBuffers(const TracedMessage& message) -> std::array<std::span<const std::byte>, 2> {
+  return { std::span<const std::byte>{ message.header }, std::span<const std::byte>{ message.payload } };
+}
+
+template <std::size_t N>
+auto buffersSize(const std::array<std::span<const std::byte>, N>& buffers) -> std::size_t {
+  std::size_t size = 0;
+  for (const auto& buffer : buffers) {
+    size += buffer.size();
+  }
+  return size;
+}
+
+/// Returns `header` followed by `buffers`, to send them with one vectored submission.
+template <std::size_t N>
+auto withHeader(std::span<const std::byte> header, const std::array<std::span<const std::byte>, N>& buffers)
+    -> std::array<std::span<const std::byte>, N + 1> {
+  std::array<std::span<const std::byte>, N + 1> result;
+  result[0] = header;
+  std::ranges::copy(buffers, result.begin() + 1);
+  return result;
+}
+
 template <typename Container, typename... Ts>
 auto recv(heph::net::Socket& socket, Ts&&... ts) {
   auto message = Container{ std::forward<Ts>(ts)... };
-  return stdexec::just(static_cast<std::uint16_t>(0)) |
+  return stdexec::just(FrameSizeT{ 0 }) |
          stdexec::let_value([&socket, message = std::move(message)](auto& size) {
            return heph::net::recvAll(socket, std::as_writable_bytes(std::span{ &size, 1 })) |
                   stdexec::let_value([&socket, &size, message = std::move(message)](auto /*unused*/) mutable {
+                    checkFrameSize(size);
                     message.resize(size);
                     return heph::net::recvAll(socket, std::as_writable_bytes(std::span{ message })) |
                            stdexec::then([&message](auto /*unused*/) { return std::move(message); });
                   });
          });
 }
+
+/// Sends the size and the payload with one vectored submission.
 template <typename Container>
 auto send(heph::net::Socket& socket, const Container& message) {
-  if (message.size() > std::numeric_limits<std::uint16_t>::max()) {
-    heph::panic("message too big ({})", message.size());
-  }
-
-  return stdexec::just(static_cast<std::uint16_t>(message.size())) |
-         stdexec::let_value([&socket, &message](const std::uint16_t& size) {
-           return heph::net::sendAll(socket, std::as_bytes(std::span{ &size, 1 })) |
-                  stdexec::let_value([&socket, &message](auto /*unused*/) {
-                    return heph::net::sendAll(socket, std::as_bytes(std::span{ message })) |
-                           stdexec::then([](auto /*unused*/) {});
-                  });
+  return stdexec::just(static_cast<FrameSizeT>(message.size())) |
+         stdexec::let_value([&socket, &message](const FrameSizeT& size) {
+           return heph::net::sendMsgAll(socket, std::array{ std::as_bytes(std::span{ &size, 1 }),
+                                                            std::as_bytes(std::span{ message }) }) |
+                  stdexec::then([](std::size_t /*unused*/) {});
          });
 }
 
+/// Sends frames over a connection. On IPC connections, large payloads are copied into a shared memory
+/// ring created for the connection and only their position is sent, which saves the copies through
+/// the kernel. Payloads not fitting into the ring until the reader catches up are sent inline.
+class FrameWriter {
+public:
+  /// Smaller payloads are cheaper to send inline than to announce.
+  static constexpr std::size_t SHARED_MEMORY_MIN_SIZE = 4 * 1024;
+
+  /// The ring is only created once the first large payload is sent, a capacity of zero sends all
+  /// payloads inline.
+  explicit FrameWriter(std::size_t ring_capacity = heph::net::SharedMemoryRing::DEFAULT_CAPACITY)
+    : ring_capacity_(ring_capacity) {
+  }
+
+  template <typename Container>
+  auto write(heph::net::Socket& socket, const Container& message) -> exec::task<void> {
+    const auto buffers = messageBuffers(message);
+    const auto size = buffersSize(buffers);
+    checkFrameSize(size);
+    if (ring_capacity_ != 0 && socket.type() == heph::net::SocketType::UNIX &&
+        size >= SHARED_MEMORY_MIN_SIZE) {
+      if (!ring_.has_value()) {
+        ring_.emplace(heph::net::SharedMemoryRing::create(ring_capacity_));
+        const FrameSizeT header = SHARED_MEMORY_ANNOUNCEMENT | ring_->name().size();
+        co_await heph::net::sendMsgAll(socket, std::array{ std::as_bytes(std::span{ &header, 1 }),
+                                                           std::as_bytes(std::span{ ring_->name() }) });
+      }
+      if (const auto position = ring_->tryWrite(buffers); position.has_value()) {
+        const SharedMemoryDescriptorT descriptor{ *position, size };
+        const FrameSizeT header = SHARED_MEMORY_FRAME | sizeof(descriptor);
+        const std::span<const std::uint64_t> descriptor_span{ descriptor };
+        co_await heph::net::sendMsgAll(socket, std::array{ std::as_bytes(std::span{ &header, 1 }),
+                                                           std::as_bytes(descriptor_span) });
+        co_return;
+      }
+    }
+    const FrameSizeT header = size;
+    co_await heph::net::sendMsgAll(socket, withHeader(std::as_bytes(std::span{ &header, 1 }), buffers));
+  }
+
+  /// Drops the shared memory ring, needs to be called when the connection got replaced.
+  void reset() {
+    ring_.reset();
+  }
+
+private:
+  std::size_t ring_capacity_;
+  std::optional<heph::net::SharedMemoryRing> ring_;
+};
+
+/// Message received by a `FrameReader`. Payloads passed through the shared memory ring are borrowed
+/// from it and only released once the message is destroyed or cleared, they are deserialized straight
+/// from the ring. Other payloads are received into `buffer`.
+class ReceivedMessage {
+public:
+  explicit ReceivedMessage(std::pmr::memory_resource* memory_resource) : buffer(memory_resource) {
+  }
+
+  ~ReceivedMessage() noexcept {
+    release();
+  }
+
+  ReceivedMessage(const ReceivedMessage&) = delete;
+  auto operator=(const ReceivedMessage&) -> ReceivedMessage& = delete;
+
+  ReceivedMessage(ReceivedMessage&& other) noexcept
+    : buffer(std::move(other.buffer))
+    , ring_(std::exchange(other.ring_, nullptr))
+    , position_(other.position_)
+    , borrowed_(other.borrowed_) {
+  }
+
+  auto operator=(ReceivedMessage&& other) noexcept -> ReceivedMessage& {
+    release();
+    buffer = std::move(other.buffer);
+    ring_ = std::exchange(other.ring_, nullptr);
+    position_ = other.position_;
+    borrowed_ = other.borrowed_;
+    return *this;
+  }
+
+  [[nodiscard]] auto data() const -> std::span<const std::byte> {
+    return ring_ != nullptr ? borrowed_ : std::as_bytes(std::span{ buffer });
+  }
+
+  [[nodiscard]] auto empty() const -> bool {
+    return data().empty();
+  }
+
+  void clear() {
+    release();
+    buffer.clear();
+  }
+
+  /// Refers to the payload of `size` bytes at `position` of `ring`, which needs to outlive the message.
+  void borrow(heph::net::SharedMemoryRing& ring, std::uint64_t position, std::size_t size) {
+    clear();
+    borrowed_ = ring.read(position, size);
+    ring_ = &ring;
+    position_ = position;
+  }
+
+  std::pmr::vector<std::byte> buffer;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+  void release() noexcept {
+    if (ring_ != nullptr) {
+      ring_->release(position_, borrowed_.size());
+      ring_ = nullptr;
+    }
+  }
+
+private:
+  heph::net::SharedMemoryRing* ring_{ nullptr };
+  std::uint64_t position_{ 0 };
+  std::span<const std::byte> borrowed_;
+};
+
+/// Receives frames from a connection. Every receive scatters into the remainder of the current frame
+/// followed by a staging buffer picking up the beginning of the next frames, small frames arriving
+/// back to back therefore mostly cost less than one receive each, large frames land directly in their
+/// destination.
+/// \note Once used, all data of the connection needs to be received by the same reader.
+class FrameReader {
+public:
+  static constexpr std::size_t STAGING_SIZE = 64 * 1024;
+
+  /// Receives the next message. Protocol violations of the peer, e.g. an invalid shared memory frame,
+  /// throw `std::system_error`, the connection needs to be dropped then.
+  /// \note The message needs to be destroyed or cleared before reading the next one.
+  auto read(heph::net::Socket& socket, ReceivedMessage& message) -> exec::task<void> {
+    while (true) {
+      const auto header = co_await readHeader(socket);
+      const auto size = header & ~FRAME_FLAGS;
+      checkFrameSize(size);
+
+      if ((header & SHARED_MEMORY_ANNOUNCEMENT) != 0) {
+        std::string name(size, '\0');
+        co_await readPayload(socket, std::as_writable_bytes(std::span{ name }));
+        ring_.emplace(heph::net::SharedMemoryRing::attach(name));
+        continue;
+      }
+
+      if ((header & SHARED_MEMORY_FRAME) != 0) {
+        SharedMemoryDescriptorT descriptor{};
+        if (size != sizeof(descriptor) || !ring_.has_value()) {
+          throw std::system_error(EPROTO, std::system_category(),
+                                  fmt::format("Unexpected shared memory frame of {} bytes", size));
+        }
+        co_await readPayload(socket, std::as_writable_bytes(std::span{ descriptor }));
+        const auto [position, payload_size] = descriptor;
+        message.borrow(*ring_, position, payload_size);
+        co_return;
+      }
+
+      message.clear();
+      message.buffer.resize(size);
+      co_await readPayload(socket, std::as_writable_bytes(std::span{ message.buffer }));
+      co_return;
+    }
+  }
+
+  /// Drops the staged data, needs to be called when the connection got replaced.
+  void reset() {
+    begin_ = 0;
+    end_ = 0;
+    ring_.reset();
+  }
+
+private:
+  auto readHeader(heph::net::Socket& socket) -> exec::task<FrameSizeT> {
+    while (end_ - begin_ < sizeof(FrameSizeT)) {
+      co_await fill(socket, {});
+    }
+    FrameSizeT header{ 0 };
+    std::memcpy(&header, staging_.data() + begin_, sizeof(header));
+    begin_ += sizeof(header);
+    co_return header;
+  }
+
+  auto readPayload(heph::net::Socket& socket, std::span<std::byte> payload) -> exec::task<void> {
+    const auto staged = std::min<std::size_t>(payload.size(), end_ - begin_);
+    std::memcpy(payload.data(), staging_.data() + begin_, staged);
+    begin_ += staged;
+    payload = payload.subspan(staged);
+    while (!payload.empty()) {
+      payload = payload.subspan(co_await fill(socket, payload));
+    }
+  }
+
+  /// Receives into `remainder` first and the staging buffer after, returns the number of bytes
+  /// received into `remainder`.
+  auto fill(heph::net::Socket& socket, std::span<std::byte> remainder) -> exec::task<std::size_t> {
+    if (begin_ != 0) {
+      std::memmove(staging_.data(), staging_.data() + begin_, end_ - begin_);
+      end_ -= begin_;
+      begin_ = 0;
+    }
+    const auto received =
+        co_await heph::net::recvMsg(socket, std::array{ remainder, std::span{ staging_ }.subspan(end_) });
+    const auto into_remainder = std::min(received, remainder.size());
+    end_ += received - into_remainder;
+    co_return into_remainder;
+  }
+
+private:
+  std::vector<std::byte> staging_ = std::vector<std::byte>(STAGING_SIZE);
+  std::size_t begin_{ 0 };
+  std::size_t end_{ 0 };
+  std::optional<heph::net::SharedMemoryRing> ring_;
+};
+
 template <typename T>
 auto createNetEntity(const heph::net::Endpoint& endpoint, heph::concurrency::Context& context) {
   switch (endpoint.type()) {
@@ -88,6 +410,8 @@ auto createNetEntity(const heph::net::Endpoint& endpoint, heph::concurrency::Con
       return T::createTcpIpV4(context);
     case heph::net::EndpointType::IPV6:
       return T::createTcpIpV6(context);
+    case heph::net::EndpointType::IPC:
+      return T::createUnix(context);
     default:
       heph::panic("Unknown endpoint type");
   }
@@ -106,54 +430,352 @@ inline auto connect(heph::net::Socket& socket, const heph::net::Endpoint& endpoi
          });
 }
 
-inline auto sendMsg(heph::net::Socket& socket, std::string name, std::vector<std::byte> msg) {
-  const auto msg_size = msg.size();
-  if (msg_size > std::numeric_limits<std::uint16_t>::max()) {
-    heph::panic("Message size too big");
+/// Turns errors of a connection into stopping the node serving it, logged as `message`. Other
+/// connections are not affected.
+inline auto stopOnError(std::string name, std::string_view message) {
+  return stdexec::let_error([name = std::move(name), message]<typename Error>(const Error& error) {
+    if constexpr (std::is_same_v<std::error_code, Error>) {
+      heph::log(heph::INFO, std::string{ message }, "node", name, "reason", error.message());
+
+    } else {
+      std::string reason;
+      try {
+        std::rethrow_exception(error);
+      } catch (std::exception& exception) {
+        reason = exception.what();
+
+      } catch (...) {
+        reason = "unknown exception";
+      }
+      heph::log(heph::INFO, std::string{ message }, "node", name, "reason", reason);
+    }
+    return stdexec::just_stopped();
+  });
+}
+
+/// Turns errors of a publishing connection into stopping the publisher.
+inline auto stopPublishingOnError(std::string name) {
+  return stopOnError(std::move(name), "Stop publishing");
+}
+
+/// Turns errors of a subscribing connection into stopping the subscriber.
+inline auto stopSubscribingOnError(std::string name) {
+  return stopOnError(std::move(name), "Stop subscribing");
+}
+
+/// Sends `msg`, which needs to stay alive until the returned sender completed.
+template <typename WriterT, typename MessageT>
+auto sendMsg(WriterT& writer, heph::net::Socket& socket, std::string name, const MessageT& msg) {
+  return writer.write(socket, msg) | stopPublishingOnError(std::move(name));
+}
+
+/// Acknowledgements carry the cumulative number of messages received on a connection.
+using SequenceT = std::uint64_t;
+
+/// Datagrams stay below the MTU of common links, larger messages are split into fragments.
+inline constexpr std::size_t MAX_DATAGRAM_SIZE = 1400;
+
+/// Precedes the fragment carried by each datagram.
+struct DatagramHeader {
+  SequenceT sequence{ 0 };
+  /// Size of the whole message.
+  std::uint64_t size{ 0 };
+  std::uint32_t fragment{ 0 };
+  std::uint32_t fragment_count{ 0 };
+};
+
+inline constexpr std::size_t MAX_FRAGMENT_SIZE = MAX_DATAGRAM_SIZE - sizeof(DatagramHeader);
+
+/// Returns the number of datagrams a message of `size` bytes is sent in, empty messages take one.
+constexpr auto fragmentCount(std::uint64_t size) -> std::uint64_t {
+  return std::max<std::uint64_t>((size + MAX_FRAGMENT_SIZE - 1) / MAX_FRAGMENT_SIZE, 1);
+}
+
+/// Sends messages as sequenced datagrams.
+class DatagramWriter {
+public:
+  template <typename Container>
+  auto write(heph::net::Socket& socket, const Container& message) -> exec::task<void> {
+    const auto buffers = messageBuffers(message);
+    const auto size = buffersSize(buffers);
+    checkFrameSize(size);
+    DatagramHeader header{ .sequence = ++sequence_,
+                           .size = size,
+                           .fragment = 0,
+                           .fragment_count = static_cast<std::uint32_t>(fragmentCount(size)) };
+    for (; header.fragment != header.fragment_count; ++header.fragment) {
+      const auto offset = header.fragment * MAX_FRAGMENT_SIZE;
+      const auto fragment = slice(buffers, offset, std::min(MAX_FRAGMENT_SIZE, size - offset));
+      co_await heph::net::sendMsgAll(socket, withHeader(std::as_bytes(std::span{ &header, 1 }), fragment));
+    }
+  }
+
+  /// Needs to be called for a new connection.
+  void reset() {
+    sequence_ = 0;
+  }
+
+private:
+  /// Returns the part of the concatenated `buffers` of `length` bytes starting at `offset`.
+  template <std::size_t N>
+  static auto slice(const std::array<std::span<const std::byte>, N>& buffers, std::size_t offset,
+                    std::size_t length) -> std::array<std::span<const std::byte>, N> {
+    std::array<std::span<const std::byte>, N> result;
+    for (std::size_t i = 0; i != N; ++i) {
+      const auto skip = std::min(offset, buffers[i].size());
+      result[i] = buffers[i].subspan(skip, std::min(length, buffers[i].size() - skip));
+      offset -= skip;
+      length -= result[i].size();
+    }
+    return result;
+  }
+
+private:
+  SequenceT sequence_{ 0 };
+};
+
+/// Reassembles sequenced datagrams into messages. Only ever moves forward: fragments of messages
+/// older than the last one delivered are dropped, as is an incomplete message once fragments of a
+/// newer one arrive. A lost datagram therefore only costs its message, never the following ones.
+/// Datagrams which don't describe a valid fragment of the message being assembled are dropped.
+class DatagramReader {
+public:
+  template <typename Container>
+  auto read(heph::net::Socket& socket, Container& message) -> exec::task<void> {
+    DatagramHeader assembling;
+    std::uint32_t missing{ 0 };
+    while (true) {
+      DatagramHeader header;
+      const auto received = co_await heph::net::recvMsg(
+          socket,
+          std::array{ std::as_writable_bytes(std::span{ &header, 1 }), std::span<std::byte>{ fragment_ } });
+      if (received < sizeof(header) || header.sequence <= delivered_ ||
+          header.sequence < assembling.sequence || !isValidFragment(header, received - sizeof(header))) {
+        continue;
+      }
+
+      if (header.sequence != assembling.sequence) {
+        assembling = header;
+        missing = header.fragment_count;
+        message.resize(header.size);
+        fragments_.assign(header.fragment_count, false);
+      } else if (header.size != assembling.size) {
+        // The fragment count follows from the size, see `isValidFragment`.
+        continue;
+      }
+      if (fragments_[header.fragment]) {
+        continue;
+      }
+      const auto offset = std::uint64_t{ header.fragment } * MAX_FRAGMENT_SIZE;
+      const auto fragment_size = received - sizeof(header);
+      fragments_[header.fragment] = true;
+      std::memcpy(std::as_writable_bytes(std::span{ message }).data() + offset, fragment_.data(),
+                  fragment_size);
+      if (--missing == 0) {
+        delivered_ = assembling.sequence;
+        co_return;
+      }
+    }
   }
 
-  return (stdexec::just(std::move(msg)) |
-          stdexec::let_value([&socket](const auto& data) { return internal::send(socket, data); }) |
-          stdexec::let_error([name = std::move(name)]<typename Error>(const Error& error) {
-            if constexpr (std::is_same_v<std::error_code, Error>) {
-              heph::log(heph::INFO, "Stop publishing", "node", name, "reason", error.message());
+  /// Needs to be called for a new connection.
+  void reset() {
+    delivered_ = 0;
+  }
 
-            } else {
-              std::string reason;
-              try {
-                std::rethrow_exception(error);
-              } catch (std::exception& exception) {
-                reason = exception.what();
+private:
+  /// Checks that the datagram carries exactly the part of the message `header` announces it as, as
+  /// the writer splits it.
+  static auto isValidFragment(const DatagramHeader& header, std::size_t fragment_size) -> bool {
+    if (header.size > MAX_FRAME_SIZE || header.fragment_count != fragmentCount(header.size) ||
+        header.fragment >= header.fragment_count) {
+      return false;
+    }
+    const auto offset = std::uint64_t{ header.fragment } * MAX_FRAGMENT_SIZE;
+    return fragment_size == std::min<std::uint64_t>(MAX_FRAGMENT_SIZE, header.size - offset);
+  }
 
-              } catch (...) {
-                reason = "unknown exception";
-              }
-              heph::log(heph::INFO, "Stop publishing", "node", name, "reason", reason);
-            }
-            return stdexec::just_stopped();
-          }));
+private:
+  std::array<std::byte, MAX_FRAGMENT_SIZE> fragment_{};
+  std::vector<bool> fragments_;
+  SequenceT delivered_{ 0 };
+};
+
+inline auto createDatagramSocket(const heph::net::Endpoint& endpoint, heph::concurrency::Context& context) {
+  switch (endpoint.type()) {
+    case heph::net::EndpointType::IPV4:
+      return heph::net::Socket::createUdpIpV4(context);
+    case heph::net::EndpointType::IPV6:
+      return heph::net::Socket::createUdpIpV6(context);
+    default:
+      heph::panic("Datagram connections need an IP endpoint, got {}", endpoint);
+  }
+  __builtin_unreachable();
 }
+
+inline void checkDatagramType(const heph::net::Endpoint& endpoint, const RemoteNodeType& type) {
+  if (!type.datagram) {
+    return;
+  }
+  if (type.reliable) {
+    heph::panic("Datagram connections are unreliable, {} asked for a reliable one", endpoint);
+  }
+  if (endpoint.type() != heph::net::EndpointType::IPV4 && endpoint.type() != heph::net::EndpointType::IPV6) {
+    heph::panic("Datagram connections need an IP endpoint, got {}", endpoint);
+  }
+}
+
+inline auto withPort(const heph::net::Endpoint& endpoint, std::uint16_t port) {
+  if (endpoint.type() == heph::net::EndpointType::IPV6) {
+    return heph::net::Endpoint::createIpV6(endpoint.address(), port);
+  }
+  return heph::net::Endpoint::createIpV4(endpoint.address(), port);
+}
+
+/// Datagram sockets are negotiated over the stream connection: the receiving side binds a datagram
+/// socket to the local address of the stream and announces its port, the sending side connects to it.
+inline auto openDatagramReceiver(heph::net::Socket& stream) -> exec::task<heph::net::Socket> {
+  const auto local = stream.localEndpoint();
+  auto socket = createDatagramSocket(local, stream.context());
+  socket.bind(withPort(local, 0));
+  const std::uint16_t port = socket.localEndpoint().port();
+  co_await heph::net::sendAll(stream, std::as_bytes(std::span{ &port, 1 }));
+  co_return socket;
+}
+
+inline auto openDatagramSender(heph::net::Socket& stream) -> exec::task<heph::net::Socket> {
+  std::uint16_t port{ 0 };
+  co_await heph::net::recvAll(stream, std::as_writable_bytes(std::span{ &port, 1 }));
+  const auto remote = stream.remoteEndpoint();
+  auto socket = createDatagramSocket(remote, stream.context());
+  socket.connect(withPort(remote, port));
+  co_return socket;
+}
+
+/// Receives the next message from `socket`, completes stopped once the peer closed `stream`, nothing
+/// else is sent over it.
+template <typename Container>
+auto readDatagram(DatagramReader& reader, heph::net::Socket& socket, heph::net::Socket& stream,
+                  Container& message) {
+  auto stream_closed =
+      stdexec::just(std::byte{}) | stdexec::let_value([&stream](std::byte& data) {
+        return heph::net::recv(stream, std::span{ &data, 1 }) |
+               stdexec::let_value([](auto /*unused*/) { return stdexec::just_stopped(); }) |
+               stdexec::let_error([](auto /*unused*/) { return stdexec::just_stopped(); });
+      });
+  return exec::when_any(reader.read(socket, message), std::move(stream_closed));
+}
+
+/// Returns true if the peer closed `stream`, without blocking. Sending datagrams doesn't notice lost
+/// peers otherwise.
+inline auto peerClosed(const heph::net::Socket& stream) -> bool {
+  std::byte data{};
+  const auto res = ::recv(stream.nativeHandle(), &data, 1, MSG_PEEK | MSG_DONTWAIT);
+  return res == 0 || (res == -1 && errno != EAGAIN && errno != EWOULDBLOCK);
+}
+
+/// Publishing side of a reliable connection, bounds the number of unacknowledged messages by the
+/// window. A window of one waits for every message to be acknowledged before sending the next.
+class AckWindow {
+public:
+  explicit AckWindow(std::uint16_t size) : size_(std::max<std::uint16_t>(size, 1)) {
+  }
+
+  /// Accounts a sent message and receives acknowledgements while the window is full. Returns the
+  /// number of messages which got acknowledged, oldest first. An acknowledgement of messages which
+  /// were not sent is a protocol error of the peer, it throws `std::system_error` and the connection
+  /// needs to be dropped.
+  auto sent(heph::net::Socket& socket) -> exec::task<std::size_t> {
+    ++sent_;
+    std::size_t newly_acknowledged = 0;
+    while (sent_ - acknowledged_ >= size_) {
+      SequenceT ack{ 0 };
+      co_await heph::net::recvAll(socket, std::as_writable_bytes(std::span{ &ack, 1 }));
+      if (ack <= acknowledged_ || ack > sent_) {
+        throw std::system_error(EPROTO, std::system_category(),
+                                fmt::format("Invalid acknowledgement {}, expected one in ({}, {}]", ack,
+                                            acknowledged_, sent_));
+      }
+      newly_acknowledged += ack - acknowledged_;
+      acknowledged_ = ack;
+    }
+    co_return newly_acknowledged;
+  }
+
+  /// Needs to be called for a new connection.
+  void reset() {
+    sent_ = 0;
+    acknowledged_ = 0;
+  }
+
+private:
+  SequenceT size_;
+  SequenceT sent_{ 0 };
+  SequenceT acknowledged_{ 0 };
+};
+
+/// Receiving side of a reliable connection, acknowledges cumulatively every half window.
+class Acknowledger {
+public:
+  explicit Acknowledger(std::uint16_t window) : interval_(std::max(window / 2, 1)) {
+  }
+
+  auto received(heph::net::Socket& socket) -> exec::task<void> {
+    ++received_;
+    if (received_ - acknowledged_ < interval_) {
+      co_return;
+    }
+    acknowledged_ = received_;
+    co_await heph::net::sendAll(socket, std::as_bytes(std::span{ &acknowledged_, 1 }));
+  }
+
+  /// Needs to be called for a new connection.
+  void reset() {
+    received_ = 0;
+    acknowledged_ = 0;
+  }
+
+private:
+  SequenceT interval_;
+  SequenceT received_{ 0 };
+  SequenceT acknowledged_{ 0 };
+};
 }  // namespace internal
 
 class RemoteInputSubscriberOperator {
 public:
-  using MsgT = std::pmr::vector<std::byte>;
+  using MsgT = internal::ReceivedMessage;
 
   [[nodiscard]] auto name() const -> std::string {
     return name_;
   }
 
-  RemoteInputSubscriberOperator(heph::net::Socket socket, const std::string& name, bool reliable)
+  RemoteInputSubscriberOperator(heph::net::Socket socket, const std::string& name, RemoteNodeType type)
     : socket_(std::move(socket))
     , name_(fmt::format("{}/{}", socket_.remoteEndpoint(), name))
-    , reliable_(reliable) {
+    , acknowledger_(type.window)
+    , reliable_(type.reliable)
+    , datagram_(type.datagram) {
   }
 
+  /// Errors of the connection, e.g. a peer violating the protocol, only stop this subscriber.
   auto trigger() -> exec::task<MsgT> {
-    auto msg = co_await internal::recv<std::pmr::vector<std::byte>>(socket_, &memory_resource_);
+    co_return co_await (receive() | internal::stopSubscribingOnError(name_));
+  }
+
+private:
+  auto receive() -> exec::task<MsgT> {
+    MsgT msg{ &memory_resource_ };
+    if (datagram_) {
+      if (!datagram_socket_.has_value()) {
+        datagram_socket_.emplace(co_await internal::openDatagramReceiver(socket_));
+      }
+      co_await internal::readDatagram(datagram_reader_, *datagram_socket_, socket_, msg.buffer);
+      co_return msg;
+    }
+    co_await reader_.read(socket_, msg);
     if (reliable_) {
-      std::byte ack{};
-      co_await heph::net::sendAll(socket_, std::span{ &ack, 1 });
+      co_await acknowledger_.received(socket_);
     }
     co_return msg;
   }
@@ -162,7 +784,12 @@ private:
   heph::net::Socket socket_;
   std::string name_;
   std::pmr::unsynchronized_pool_resource memory_resource_;
+  internal::FrameReader reader_;
+  internal::Acknowledger acknowledger_;
+  std::optional<heph::net::Socket> datagram_socket_;
+  internal::DatagramReader datagram_reader_;
   bool reliable_;
+  bool datagram_;
 };
 
 template <typename T>
@@ -175,37 +802,70 @@ struct RemoteInputSubscriber : heph::conduit::Node<RemoteInputSubscriber<T>, Rem
     return self.data().trigger();
   }
 
-  static auto execute(RemoteInputSubscriberOperator::MsgT msg) -> std::optional<T> {
-    auto msg_buffer = std::span{ msg };
+  static auto execute(RemoteInputSubscriber& self, RemoteInputSubscriberOperator::MsgT msg)
+      -> std::optional<T> {
+    auto msg_buffer = msg.data();
     if (msg_buffer.empty()) {
       // No data received...
       return std::nullopt;
     }
 
     T value;
-    heph::serdes::deserialize(msg_buffer, value);
+    const auto trace = internal::deserializeTraced(msg_buffer, value);
+    if (!trace.has_value()) {
+      heph::log(heph::ERROR, "Dropping message missing the trace header", "node", self.nodeName(), "size",
+                msg_buffer.size());
+      return std::nullopt;
+    }
+    self.consumeTrace(*trace);
     return value;
   }
 };
 
 class RemoteOutputPublisherOperator {
 public:
-  explicit RemoteOutputPublisherOperator(heph::net::Socket client, const std::string& name, bool reliable)
+  explicit RemoteOutputPublisherOperator(heph::net::Socket client, const std::string& name,
+                                         RemoteNodeType type, std::size_t shared_memory_ring_capacity)
     : socket_(std::move(client))
     , remote_endpoint_(socket_.remoteEndpoint())
     , name_(fmt::format("{}/{}", remote_endpoint_, name))
-    , reliable_(reliable) {
+    , writer_(shared_memory_ring_capacity)
+    , window_(type.window)
+    , reliable_(type.reliable)
+    , datagram_(type.datagram) {
   }
 
   [[nodiscard]] auto name() const -> std::string {
     return name_;
   }
 
-  auto publish(std::vector<std::byte> msg) -> exec::task<void> {
-    co_await internal::sendMsg(socket_, name(), std::move(msg));
+  auto publish(SharedValue<internal::TracedMessage> msg) -> exec::task<void> {
+    if (datagram_) {
+      if (internal::peerClosed(socket_)) {
+        heph::log(heph::INFO, "Stop publishing", "node", name(), "reason", "connection closed");
+        co_await stdexec::just_stopped();
+      }
+      if (!datagram_socket_.has_value()) {
+        datagram_socket_.emplace(
+            co_await (internal::openDatagramSender(socket_) | internal::stopPublishingOnError(name())));
+      }
+      co_await internal::sendMsg(datagram_writer_, *datagram_socket_, name(), *msg);
+      co_return;
+    }
     if (reliable_) {
-      std::byte ack{};
-      co_await heph::net::recvAll(socket_, std::span<std::byte>{ &ack, 1 });
+      // Values are dropped from the queue of a client which is too far behind, the subscriber would
+      // silently miss them.
+      if (last_sequence_.has_value() && msg->sequence != *last_sequence_ + 1) {
+        heph::log(heph::INFO, "Stop publishing", "node", name(), "reason", "client fell behind", "dropped",
+                  msg->sequence - *last_sequence_ - 1);
+        co_await stdexec::just_stopped();
+      }
+      last_sequence_ = msg->sequence;
+    }
+    co_await internal::sendMsg(writer_, socket_, name(), *msg);
+    if (reliable_) {
+      // The subscriber is served by this connection only, nothing to retransmit once it is gone.
+      (void)co_await (window_.sent(socket_) | internal::stopPublishingOnError(name()));
     }
   }
 
@@ -213,13 +873,56 @@ private:
   heph::net::Socket socket_;
   heph::net::Endpoint remote_endpoint_;
   std::string name_;
+  internal::FrameWriter writer_;
+  internal::AckWindow window_;
+  std::optional<heph::net::Socket> datagram_socket_;
+  internal::DatagramWriter datagram_writer_;
+  std::optional<std::uint64_t> last_sequence_;
   bool reliable_;
+  bool datagram_;
+};
+
+/// Serializes the values of an output once for all remote clients subscribed to it. The clients'
+/// publishers borrow the serialized message.
+template <typename T>
+struct RemoteOutputSerializerNode : conduit::Node<RemoteOutputSerializerNode<T>, std::string> {
+  QueuedInput<T> input{ this, "input" };
+  std::uint64_t sequence{ 0 };
+
+  static auto name(const RemoteOutputSerializerNode& self) {
+    return fmt::format("{}/serializer", self.data());
+  }
+
+  static auto trigger(RemoteOutputSerializerNode& self) {
+    return self.input.get();
+  }
+
+  static auto execute(RemoteOutputSerializerNode& self, const T& t)
+      -> std::optional<internal::TracedMessage> {
+    // Publishers are removed once their client disconnected, no need to serialize without any left.
+    if (!self.hasOutputConnections()) {
+      return std::nullopt;
+    }
+    auto msg = internal::serializeTraced(t, self.outputTrace());
+    msg.sequence = self.sequence++;
+    return msg;
+  }
 };
 
-template <typename T, typename InputPolicyT = InputPolicy<>>
+/// Values queued per reliable client before it counts as stalled.
+inline constexpr std::size_t RELIABLE_PUBLISHER_DEPTH = 64;
+/// Every client has its own bounded queue, the serializer never waits for a client being behind.
+/// Reliable clients get disconnected once their queue overflowed, they reconnect and continue with the
+/// latest values.
+using ReliablePublisherPolicy =
+    InputPolicy<RELIABLE_PUBLISHER_DEPTH, RetrievalMethod::BLOCK, SetMethod::OVERWRITE>;
+/// Unreliable clients drop the oldest value when they are behind.
+using UnreliablePublisherPolicy = InputPolicy<1, RetrievalMethod::BLOCK, SetMethod::OVERWRITE>;
+
+template <typename InputPolicyT = ReliablePublisherPolicy>
 struct RemoteOutputPublisherNode
-  : conduit::Node<RemoteOutputPublisherNode<T, InputPolicyT>, RemoteOutputPublisherOperator> {
-  QueuedInput<T, InputPolicyT> input{ this, "input" };
+  : conduit::Node<RemoteOutputPublisherNode<InputPolicyT>, RemoteOutputPublisherOperator> {
+  QueuedInput<SharedValue<internal::TracedMessage>, InputPolicyT> input{ this, "input" };
 
   static auto name(const RemoteOutputPublisherNode& self) {
     return self.data().name();
@@ -229,8 +932,8 @@ struct RemoteOutputPublisherNode
     return self.input.get();
   }
 
-  static auto execute(RemoteOutputPublisherNode& self, const T& t) {
-    return self.data().publish(heph::serdes::serialize(t));
+  static auto execute(RemoteOutputPublisherNode& self, SharedValue<internal::TracedMessage> msg) {
+    return self.data().publish(std::move(msg));
   }
 };
 }  // namespace heph::conduit
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory_resource>
 #include <optional>
 #include <span>
@@ -21,18 +22,22 @@
 #include "hephaestus/net/endpoint.h"
 #include "hephaestus/net/socket.h"
 #include "hephaestus/serdes/serdes.h"
+#include "hephaestus/telemetry/log/log.h"
 
 namespace heph::conduit {
 
 namespace internal {
 class RemoteSubscriberOperator {
 public:
-  using MsgT = std::pmr::vector<std::byte>;
+  using MsgT = ReceivedMessage;
 
-  explicit RemoteSubscriberOperator(heph::net::Endpoint endpoint, std::string name, bool reliable = true)
+  explicit RemoteSubscriberOperator(heph::net::Endpoint endpoint, std::string name, bool reliable = true,
+                                    std::uint16_t window = 1, bool datagram = false)
     : endpoint_(std::move(endpoint))
+    , acknowledger_(window)
     , name_(std::move(name))
-    , type_{ .type = RemoteNodeType::OUTPUT, .reliable = reliable } {
+    , type_{ .type = RemoteNodeType::OUTPUT, .reliable = reliable, .window = window, .datagram = datagram } {
+    internal::checkDatagramType(endpoint_, type_);
   }
 
   [[nodiscard]] auto name() const -> std::string {
@@ -46,6 +51,10 @@ private:
   std::optional<heph::net::Socket> socket_;
   heph::net::Endpoint endpoint_;
   std::pmr::unsynchronized_pool_resource memory_resource_;
+  FrameReader reader_;
+  Acknowledger acknowledger_;
+  std::optional<heph::net::Socket> datagram_socket_;
+  DatagramReader datagram_reader_;
   std::string name_;
   std::string type_info_;
   std::optional<std::string> last_error_;
@@ -63,18 +72,25 @@ struct RemoteOutputSubscriber
   }
 
   static auto trigger(RemoteOutputSubscriber* self) {
-    return self->data().trigger(&self->engine().scheduler().context(), &self->type_info);
+    return self->data().trigger(&self->scheduler().context(), &self->type_info);
   }
 
-  static auto execute(internal::RemoteSubscriberOperator::MsgT msg) -> std::optional<T> {
-    auto msg_buffer = std::span{ msg };
+  static auto execute(RemoteOutputSubscriber& self, internal::RemoteSubscriberOperator::MsgT msg)
+      -> std::optional<T> {
+    auto msg_buffer = msg.data();
     if (msg_buffer.empty()) {
       // No data received...
       return std::nullopt;
     }
 
     T value;
-    heph::serdes::deserialize(msg_buffer, value);
+    const auto trace = internal::deserializeTraced(msg_buffer, value);
+    if (!trace.has_value()) {
+      heph::log(heph::ERROR, "Dropping message missing the trace header", "node", self.nodeName(), "size",
+                msg_buffer.size());
+      return std::nullopt;
+    }
+    self.consumeTrace(*trace);
     return value;
   }
 };
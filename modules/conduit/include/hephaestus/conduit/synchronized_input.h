@@ -0,0 +1,296 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/conduit/detail/awaiter.h"
+#include "hephaestus/conduit/detail/input_base.h"
+#include "hephaestus/conduit/detail/node_base.h"
+#include "hephaestus/conduit/input.h"
+#include "hephaestus/conduit/node.h"
+#include "hephaestus/containers/intrusive_fifo_queue.h"
+
+namespace heph::conduit {
+
+/// Provides the time stamp values of `T` are synchronized by. Defaults to the `timestamp` member,
+/// either a `std::chrono::time_point` or a duration since some epoch. Specialize it for types
+/// carrying their time stamp differently. All inputs of a `SynchronizedInput` need to use the same
+/// clock.
+template <typename T>
+struct SynchronizationTraits {
+  static auto timestamp(const T& value) -> std::chrono::nanoseconds {
+    if constexpr (requires { value.timestamp.time_since_epoch(); }) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(value.timestamp.time_since_epoch());
+    } else {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(value.timestamp);
+    }
+  }
+};
+
+namespace detail {
+template <typename T>
+auto synchronizationTimestamp(const T& value) -> std::chrono::nanoseconds {
+  if constexpr (ISSHAREDVALUE<T>) {
+    return SynchronizationTraits<SharedValueElementT<T>>::timestamp(*value);
+  } else {
+    return SynchronizationTraits<T>::timestamp(value);
+  }
+}
+
+/// One of the inputs of a `SynchronizedInput`. Values are only buffered here, they are retrieved
+/// through the `SynchronizedInput` once every input holds a matching one.
+template <typename T, typename InputPolicy, typename SynchronizedInputT>
+class SynchronizedInputPort
+  : public InputBase<SynchronizedInputPort<T, InputPolicy, SynchronizedInputT>, T, InputPolicy::DEPTH> {
+  using BaseT = InputBase<SynchronizedInputPort<T, InputPolicy, SynchronizedInputT>, T, InputPolicy::DEPTH>;
+
+public:
+  using ValueT = T;
+  using InputPolicyT = InputPolicy;
+
+  SynchronizedInputPort(NodeBase* node, std::string name, SynchronizedInputT* synchronized_input)
+    : BaseT(node, std::move(name)), synchronized_input_(synchronized_input) {
+  }
+
+  /// Returns the time stamp of the oldest buffered value.
+  [[nodiscard]] auto oldestTimestamp() const -> std::optional<std::chrono::nanoseconds> {
+    const T* oldest = this->buffer_.front();
+    if (oldest == nullptr) {
+      return std::nullopt;
+    }
+    return synchronizationTimestamp(*oldest);
+  }
+
+  [[nodiscard]] auto peekValue() -> std::optional<T> {
+    return this->buffer_.peek();
+  }
+
+  [[nodiscard]] auto getValue() -> std::optional<T> {
+    return this->popValue();
+  }
+
+  void dropValue() {
+    this->discardValue();
+  }
+
+  /// Called by the base for every value set, the synchronized input decides whether it completes a
+  /// match.
+  void triggerAwaiter() {
+    synchronized_input_->triggerAwaiter();
+  }
+
+private:
+  SynchronizedInputT* synchronized_input_;
+};
+
+template <std::size_t I, typename PortT>
+struct SynchronizedPortHolder {
+  PortT port;
+};
+
+/// Holds the ports in place, they can't be moved once registered with their node.
+template <typename Indices, typename... PortTs>
+class SynchronizedPorts;
+
+template <std::size_t... Is, typename... PortTs>
+class SynchronizedPorts<std::index_sequence<Is...>, PortTs...> : SynchronizedPortHolder<Is, PortTs>... {
+public:
+  template <typename SynchronizedInputT>
+  SynchronizedPorts(NodeBase* node, std::array<std::string, sizeof...(PortTs)> names,
+                    SynchronizedInputT* synchronized_input)
+    : SynchronizedPortHolder<Is, PortTs>{ PortTs{ node, std::move(names[Is]), synchronized_input } }... {
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] auto get() -> auto& {
+    return getHolder<I>(*this).port;
+  }
+
+  /// Calls `f` with all ports, in order.
+  template <typename F>
+  auto apply(F&& f) {
+    return std::forward<F>(f)(static_cast<SynchronizedPortHolder<Is, PortTs>&>(*this).port...);
+  }
+
+private:
+  template <std::size_t I, typename PortT>
+  static auto getHolder(SynchronizedPortHolder<I, PortT>& holder) -> SynchronizedPortHolder<I, PortT>& {
+    return holder;
+  }
+};
+}  // namespace detail
+
+/// Input combining several inputs, pairing their values by time stamp. The node gets triggered once
+/// with a tuple of values, one of each input, whose time stamps are at most `tolerance` apart. A
+/// tolerance of zero only matches identical time stamps. Values which can't be matched anymore, as
+/// they are older than the tolerance allows for the oldest value of another input, are dropped.
+/// Values of each input are expected to arrive in order of their time stamps, see
+/// `SynchronizationTraits` for how they are retrieved. Every input buffers up to `InputPolicy::DEPTH`
+/// values and follows the `SetMethod` of the policy once full.
+template <typename InputPolicy, typename... Ts>
+class SynchronizedInputBase {
+  static_assert(sizeof...(Ts) > 1, "Synchronizing a single input does not make sense");
+
+  template <typename T>
+  using PortT = detail::SynchronizedInputPort<T, InputPolicy, SynchronizedInputBase>;
+  using PortsT = detail::SynchronizedPorts<std::index_sequence_for<Ts...>, PortT<Ts>...>;
+
+public:
+  using ValueT = std::tuple<Ts...>;
+  using InputPolicyT = InputPolicy;
+
+  template <typename OperationT, typename DataT>
+  explicit SynchronizedInputBase(Node<OperationT, DataT>* node, std::array<std::string, sizeof...(Ts)> names,
+                                 std::chrono::nanoseconds tolerance = std::chrono::nanoseconds{ 0 })
+    : node_(node), ports_(node, std::move(names), this), tolerance_(tolerance) {
+  }
+
+  /// Returns the input taking the `I`th element of the synchronized tuples, e.g. to connect it to an
+  /// output.
+  template <std::size_t I>
+  [[nodiscard]] auto input() -> auto& {
+    return ports_.template get<I>();
+  }
+
+  [[nodiscard]] auto node() -> detail::NodeBase* {
+    return node_;
+  }
+
+  [[nodiscard]] auto get()
+    requires(InputPolicy::RETRIEVAL_METHOD == RetrievalMethod::POLL)
+  {
+    return heph::concurrency::makeSenderExpression<detail::InputPollT>(this);
+  }
+
+  /// Returns a sender which is getting triggered once every input holds a matching value.
+  [[nodiscard]] auto get()
+    requires(InputPolicy::RETRIEVAL_METHOD == RetrievalMethod::BLOCK)
+  {
+    return heph::concurrency::makeSenderExpression<detail::InputBlockT<false>>(this);
+  }
+
+  [[nodiscard]] auto peek() {
+    return heph::concurrency::makeSenderExpression<detail::InputBlockT<true>>(this);
+  }
+
+  auto peekValue() -> std::optional<ValueT> {
+    if (!match()) {
+      return std::nullopt;
+    }
+    return ports_.apply([](auto&... ports) { return ValueT{ *ports.peekValue()... }; });
+  }
+
+  auto getValue() -> std::optional<ValueT> {
+    if (!match()) {
+      return std::nullopt;
+    }
+    return ports_.apply([](auto&... ports) { return ValueT{ *ports.getValue()... }; });
+  }
+
+  /// Number of values dropped for not matching any value of the other inputs.
+  [[nodiscard]] auto dropped() const -> std::uint64_t {
+    return dropped_;
+  }
+
+  template <typename Receiver, bool Peek>
+  using Awaiter = detail::Awaiter<SynchronizedInputBase, std::decay_t<Receiver>, Peek>;
+
+private:
+  template <typename T, typename OtherInputPolicy, typename SynchronizedInputT>
+  friend class detail::SynchronizedInputPort;
+  template <typename OtherInputT, typename ReceiverT, bool Peek>
+  friend class detail::Awaiter;
+
+  /// Drops values until the oldest value of every input is part of a match. Returns false if an input
+  /// ran empty before.
+  auto match() -> bool {
+    while (true) {
+      const auto timestamps =
+          ports_.apply([](auto&... ports) { return std::array{ ports.oldestTimestamp()... }; });
+      if (std::ranges::any_of(timestamps, [](const auto& timestamp) { return !timestamp.has_value(); })) {
+        return false;
+      }
+
+      // Future values of the newest input won't be older, values too old for it never match.
+      const auto newest = **std::ranges::max_element(timestamps);
+      std::size_t dropped = 0;
+      std::size_t index = 0;
+      auto drop_stale = [&](auto& port) {
+        if (*timestamps[index++] + tolerance_ < newest) {
+          port.dropValue();
+          ++dropped;
+        }
+      };
+      ports_.apply([&](auto&... ports) { (drop_stale(ports), ...); });
+      if (dropped == 0) {
+        return true;
+      }
+      dropped_ += dropped;
+    }
+  }
+
+  void enqueueWaiter(detail::AwaiterBase* awaiter) {
+    if (containers::IntrusiveFifoQueueAccess::next(awaiter) == nullptr) {
+      if (awaiter->isPeeker()) {
+        peekers_.enqueue(awaiter);
+
+      } else {
+        awaiters_.enqueue(awaiter);
+      }
+    }
+  }
+
+  void dequeueWaiter(detail::AwaiterBase* awaiter) {
+    if (awaiter->isPeeker()) {
+      (void)peekers_.erase(awaiter);
+    } else {
+      (void)awaiters_.erase(awaiter);
+    }
+  }
+
+  void triggerAwaiter() {
+    // Awaiters only enqueue themselves once, they need to find a value when triggered.
+    if (!match()) {
+      return;
+    }
+    while (true) {
+      auto* awaiter = peekers_.dequeue();
+      if (awaiter == nullptr) {
+        break;
+      }
+      awaiter->trigger();
+    }
+
+    auto* awaiter = awaiters_.dequeue();
+    if (awaiter != nullptr) {
+      awaiter->trigger();
+    }
+  }
+
+private:
+  detail::NodeBase* node_;
+  PortsT ports_;
+  std::chrono::nanoseconds tolerance_;
+  std::uint64_t dropped_{ 0 };
+  containers::IntrusiveFifoQueue<detail::AwaiterBase> peekers_;
+  containers::IntrusiveFifoQueue<detail::AwaiterBase> awaiters_;
+};
+
+inline constexpr std::size_t SYNCHRONIZED_INPUT_DEPTH = 8;
+
+template <typename... Ts>
+using SynchronizedInput = SynchronizedInputBase<InputPolicy<SYNCHRONIZED_INPUT_DEPTH>, Ts...>;
+}  // namespace heph::conduit
@@ -0,0 +1,36 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <cstdint>
+
+#include "hephaestus/concurrency/io_ring/timer.h"
+
+namespace heph::conduit {
+
+/// Lightweight context travelling alongside propagated values if tracing is enabled in the
+/// `NodeEngineConfig`. It describes the oldest data which contributed to a value: the time it was
+/// produced by a node without traced inputs, the node which produced it and the number of nodes it
+/// passed since. Traces crossing process boundaries assume synchronized clocks.
+struct TraceContext {
+  using ClockT = concurrency::io_ring::TimerClock;
+
+  ClockT::time_point origin{};
+  std::uint64_t origin_node{ 0 };
+  std::uint32_t hops{ 0 };
+
+  /// Returns false for values which don't carry a trace, e.g. when tracing is disabled.
+  [[nodiscard]] auto valid() const -> bool {
+    return origin != ClockT::time_point{};
+  }
+
+  /// Keeps the older of both traces.
+  void merge(const TraceContext& other) {
+    if (other.valid() && (!valid() || other.origin < origin)) {
+      *this = other;
+    }
+  }
+};
+}  // namespace heph::conduit
@@ -4,17 +4,27 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <semaphore>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <utility>
+#include <vector>
 
+#include "hephaestus/concurrency/io_ring/io_ring.h"
+#include "hephaestus/concurrency/io_ring/io_ring_operation_base.h"
+#include "hephaestus/conduit/accumulated_input.h"
+#include "hephaestus/conduit/detail/awaiter.h"
 #include "hephaestus/conduit/input.h"
 #include "hephaestus/conduit/node.h"
 #include "hephaestus/conduit/queued_input.h"
+#include "hephaestus/containers/blocking_queue.h"
 #include "hephaestus/ipc/topic.h"
 #include "hephaestus/ipc/zenoh/publisher.h"
 #include "hephaestus/ipc/zenoh/raw_subscriber.h"
@@ -24,30 +34,236 @@
 
 namespace heph::conduit {
 
+/// Decides what happens to messages arriving while the handoff queue of a `ZenohSubscriberNode` is
+/// full, i.e. while the input doesn't keep up with the topic.
+enum struct SubscriberOverflowPolicy : std::uint8_t {
+  /// Drops the arriving message.
+  DROP_NEWEST,
+  /// Drops the oldest queued message to make space for the arriving one.
+  DROP_OLDEST,
+  /// Waits for space up to `ZenohSubscriberConfig::wait_deadline`, drops the arriving message afterwards.
+  /// Blocks the callback thread of the subscriber meanwhile.
+  WAIT,
+};
+
+struct ZenohSubscriberConfig {
+  SubscriberOverflowPolicy overflow_policy{ SubscriberOverflowPolicy::WAIT };
+  /// Number of messages handed over from the zenoh callback thread which didn't reach the input yet.
+  std::size_t queue_depth{ 16 };
+  std::chrono::microseconds wait_deadline{ std::chrono::milliseconds{ 100 } };
+};
+
+struct ZenohSubscriberStatistics {
+  std::uint64_t received{ 0 };
+  /// Messages which arrived at a full queue, only counted for `SubscriberOverflowPolicy::WAIT`.
+  std::uint64_t waited{ 0 };
+  std::uint64_t dropped{ 0 };
+};
+
+namespace internal {
+/// Tag of the metric recorded whenever a `ZenohSubscriberNode` drops a message.
+inline constexpr std::string_view SUBSCRIBER_OVERFLOW_METRIC_TAG = "subscriber_overflow";
+
+void recordSubscriberOverflow(const std::string& topic, SubscriberOverflowPolicy policy,
+                              const ZenohSubscriberStatistics& statistics);
+}  // namespace internal
+
+/// Feeds the messages of a zenoh topic into an input. Messages are handed over from the zenoh callback
+/// thread through a bounded queue which never waits on the node, the context of the node moves them
+/// into the input as it accepts them. Messages arriving at a full queue are handled according to the
+/// `SubscriberOverflowPolicy`. The input has to outlive the node.
 template <typename InputT>
 class ZenohSubscriberNode {
+  using DataT = typename InputT::DataT;
+  // Borrowing inputs directly take the deserialized message without an additional copy.
+  using MessageT = detail::SharedValueElementT<DataT>;
+
 public:
-  ZenohSubscriberNode(ipc::zenoh::SessionPtr session, ipc::TopicConfig topic_config, InputT& input)
+  ZenohSubscriberNode(ipc::zenoh::SessionPtr session, ipc::TopicConfig topic_config, InputT& input,
+                      ZenohSubscriberConfig config = {})
     : input_(&input)
-    , subscriber_(std::make_unique<ipc::zenoh::Subscriber<typename InputT::DataT>>(
+    , config_(config)
+    , topic_(topic_config.name)
+    , queue_(std::max<std::size_t>(config.queue_depth, 1))
+    , subscriber_(std::make_unique<ipc::zenoh::Subscriber<MessageT>>(
           std::move(session), std::move(topic_config),
-          [this](const auto&, const auto& msg) { setValue(std::move(*msg)); },
+          [this](const auto&, const auto& msg) { onMessage(msg); },
           heph::ipc::zenoh::SubscriberConfig{ .dedicated_callback_thread = true })) {
   }
 
+  ~ZenohSubscriberNode() {
+    // Releases a callback waiting for space before the subscriber joins its thread.
+    queue_.stop();
+    subscriber_.reset();
+    close();
+  }
+
+  ZenohSubscriberNode(const ZenohSubscriberNode&) = delete;
+  ZenohSubscriberNode(ZenohSubscriberNode&&) = delete;
+  auto operator=(const ZenohSubscriberNode&) -> ZenohSubscriberNode& = delete;
+  auto operator=(ZenohSubscriberNode&&) -> ZenohSubscriberNode& = delete;
+
+  [[nodiscard]] auto statistics() const -> ZenohSubscriberStatistics {
+    return { .received = received_.load(std::memory_order_relaxed),
+             .waited = waited_.load(std::memory_order_relaxed),
+             .dropped = dropped_.load(std::memory_order_relaxed) };
+  }
+
 private:
-  void setValue(typename InputT::DataT&& data) {
-    auto backoff = BACKOFF_DELAY;
-    while (input_->setValue(std::move(data)) != InputState::OK) {
-      std::this_thread::sleep_for(backoff);
-      backoff = backoff * 2;
+  /// Hand overs are scheduled at most once at a time. Closing makes the scheduled hand over, or a new
+  /// one if none is, the last one, which cancels the wait for a slot and moves to `CLOSED`.
+  enum struct HandOverState : std::uint8_t { IDLE, SCHEDULED, CLOSING, CLOSED };
+
+  struct HandOverOperation : concurrency::io_ring::IoRingOperationBase {
+    explicit HandOverOperation(ZenohSubscriberNode* node) : self(node) {
+    }
+    void handleCompletion(::io_uring_cqe* /*cqe*/) final {
+      if (self == nullptr) {
+        // The node was destroyed while its context wasn't running, see `close`.
+        delete this;  // NOLINT(cppcoreguidelines-owning-memory)
+        return;
+      }
+      self->handOver();
+    }
+    ZenohSubscriberNode* self;
+  };
+
+  struct SlotAwaiter : detail::SlotAwaiterBase {
+    explicit SlotAwaiter(ZenohSubscriberNode* node) : self(node) {
+    }
+    void slotAvailable() final {
+      // Called while the input notifies its awaiters, registering again has to wait.
+      self->scheduleHandOver();
+    }
+    ZenohSubscriberNode* self;
+  };
+
+  void onMessage(const std::shared_ptr<MessageT>& msg) {
+    if constexpr (detail::ISSHAREDVALUE<DataT>) {
+      push(DataT{ msg });
+    } else {
+      push(std::move(*msg));
+    }
+  }
+
+  /// Runs on the zenoh callback thread.
+  void push(DataT data) {
+    received_.fetch_add(1, std::memory_order_relaxed);
+    bool dropped = false;
+    switch (config_.overflow_policy) {
+      case SubscriberOverflowPolicy::DROP_NEWEST:
+        dropped = !queue_.tryPush(std::move(data));
+        break;
+      case SubscriberOverflowPolicy::DROP_OLDEST:
+        dropped = queue_.forcePush(std::move(data)).has_value();
+        break;
+      case SubscriberOverflowPolicy::WAIT:
+        if (!queue_.tryPush(std::move(data))) {
+          waited_.fetch_add(1, std::memory_order_relaxed);
+          dropped = !queue_.waitForAndPush(std::move(data), config_.wait_deadline);
+        }
+        break;
+    }
+    if (dropped) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      internal::recordSubscriberOverflow(topic_, config_.overflow_policy, statistics());
+    }
+    scheduleHandOver();
+  }
+
+  void scheduleHandOver() {
+    auto state = HandOverState::IDLE;
+    if (hand_over_state_.compare_exchange_strong(state, HandOverState::SCHEDULED)) {
+      input_->node()->scheduler().context().ring()->submit(hand_over_operation_.get());
+    }
+  }
+
+  /// Stops waiting for a slot of the input, no hand over runs once it returns. Called after the
+  /// subscriber stopped, nothing is pushed anymore.
+  void close() {
+    static constexpr std::chrono::milliseconds POLL_PERIOD{ 10 };
+    auto* ring = input_->node()->scheduler().context().ring();
+    if (!ring->isRunning() || ring->isCurrentRing()) {
+      // Nothing runs a hand over concurrently.
+      detach(hand_over_state_.exchange(HandOverState::CLOSED));
+      return;
+    }
+    // The input and the hand over are only touched on the context of the node, a last hand over cancels
+    // the wait there. A scheduled hand over which didn't start yet becomes the last one, otherwise it
+    // gets submitted here.
+    auto state = hand_over_state_.load();
+    while (!hand_over_state_.compare_exchange_weak(state, HandOverState::CLOSING)) {
+    }
+    if (state == HandOverState::IDLE) {
+      ring->submit(hand_over_operation_.get());
+    }
+    while (!closed_.try_acquire_for(POLL_PERIOD)) {
+      if (ring->isRunning()) {
+        continue;
+      }
+      // The context stopped before running the last hand over, it stays queued until it runs again.
+      state = HandOverState::CLOSING;
+      if (hand_over_state_.compare_exchange_strong(state, HandOverState::CLOSED)) {
+        detach(HandOverState::CLOSING);
+        return;
+      }
+    }
+  }
+
+  /// Cancels the wait for a slot off the context, which must not run. A hand over still queued on the
+  /// ring only completes once the context runs again, the operation then frees itself.
+  void detach(HandOverState previous) {
+    input_->cancelAwaitSlot(&slot_awaiter_);
+    if (previous != HandOverState::IDLE) {
+      hand_over_operation_.release()->self = nullptr;
+    }
+  }
+
+  /// Moves queued messages into the input, runs on the context of the node.
+  void handOver() {
+    // Reset first, messages queued from now on schedule another hand over. Fails if `close` made this
+    // the last hand over.
+    auto state = HandOverState::SCHEDULED;
+    if (!hand_over_state_.compare_exchange_strong(state, HandOverState::IDLE)) {
+      hand_over_state_.store(HandOverState::CLOSED);
+      input_->cancelAwaitSlot(&slot_awaiter_);
+      closed_.release();
+      return;
+    }
+    while (true) {
+      if (!pending_.has_value()) {
+        pending_ = queue_.tryPop();
+        if (!pending_.has_value()) {
+          return;
+        }
+      }
+      if (input_->setValue(std::move(*pending_)) == InputState::OVERFLOW) {
+        // The value is left untouched, continued once the input consumed a value.
+        input_->awaitSlot(&slot_awaiter_);
+        return;
+      }
+      pending_.reset();
     }
   }
 
 private:
-  static constexpr auto BACKOFF_DELAY = std::chrono::microseconds{ 1 };
   InputT* input_;
-  std::unique_ptr<ipc::zenoh::Subscriber<typename InputT::DataT>> subscriber_;
+  ZenohSubscriberConfig config_;
+  std::string topic_;
+  containers::BlockingQueue<DataT> queue_;
+  // Taken from the queue but rejected by the input, only accessed on the context of the node.
+  std::optional<DataT> pending_;
+  std::atomic<std::uint64_t> received_{ 0 };
+  std::atomic<std::uint64_t> waited_{ 0 };
+  std::atomic<std::uint64_t> dropped_{ 0 };
+  std::atomic<HandOverState> hand_over_state_{ HandOverState::IDLE };
+  // Released by the last hand over, see `close`.
+  std::binary_semaphore closed_{ 0 };
+  // Heap allocated to outlive the node if it is still in flight when the node is destroyed.
+  std::unique_ptr<HandOverOperation> hand_over_operation_{ std::make_unique<HandOverOperation>(this) };
+  SlotAwaiter slot_awaiter_{ this };
+  // Destroyed first, no callbacks run once the members above are gone.
+  std::unique_ptr<ipc::zenoh::Subscriber<MessageT>> subscriber_;
 };
 
 template <typename T>
@@ -77,4 +293,51 @@ struct ZenohPublisherNode : conduit::Node<ZenohPublisherNode<T, InputName>, Zeno
   }
 };
 
+/// How a `ZenohBatchPublisherNode` publishes the values gathered by one execution. Subscribers receive
+/// the values one by one in either case.
+enum struct ZenohBatchMode : std::uint8_t {
+  /// Publishes all values as a single framed sample. Only subscribers which understand framed samples,
+  /// see `ipc::zenoh::RawPublisher::publishBatch`, can receive them, opt in once all are upgraded.
+  FRAMED,
+  /// Publishes each value as its own sample, in one burst. Understood by every subscriber.
+  BURST,
+};
+
+template <typename T>
+struct ZenohBatchPublisherOperator {
+  ZenohBatchPublisherOperator(ipc::zenoh::SessionPtr session, ipc::TopicConfig topic_config,
+                              ZenohBatchMode batch_mode = ZenohBatchMode::BURST)
+    : publisher(std::move(session), std::move(topic_config)), mode(batch_mode) {
+  }
+
+  ipc::zenoh::Publisher<T> publisher;
+  ZenohBatchMode mode;
+};
+
+/// Publisher for high rate topics: each execution takes all values which arrived at the input since
+/// the last one, up to `Depth`, and publishes them together.
+template <typename T, utils::string::StringLiteral InputName, std::size_t Depth = 64>
+struct ZenohBatchPublisherNode
+  : conduit::Node<ZenohBatchPublisherNode<T, InputName, Depth>, ZenohBatchPublisherOperator<T>> {
+  AccumulatedInput<T, InputPolicy<Depth>> input{ this, std::string{ std::string_view{ InputName } } };
+
+  static auto name() -> std::string_view {
+    static constexpr auto NAME = utils::string::StringLiteral{ "zenoh_batch_publisher/" } + InputName;
+    return std::string_view{ NAME };
+  }
+
+  static auto trigger(ZenohBatchPublisherNode& self) {
+    return self.input.get();
+  }
+
+  static void execute(ZenohBatchPublisherNode& self, const std::vector<T>& values) {
+    auto& publisher = self.data().publisher;
+    if (self.data().mode == ZenohBatchMode::FRAMED) {
+      (void)publisher.publishBatch(values);
+      return;
+    }
+    (void)publisher.publishBurst(values);
+  }
+};
+
 }  // namespace heph::conduit
@@ -4,8 +4,12 @@
 
 #include "hephaestus/conduit/detail/node_base.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <string_view>
 
 #include <fmt/format.h>
 #include <stdexec/stop_token.hpp>
@@ -19,11 +23,32 @@
 
 namespace heph::conduit::detail {
 
-[[nodiscard]] auto NodeBase::nodeName() const -> std::string {
-  if (engine_ == nullptr) {
-    return nodeName("");
+[[nodiscard]] auto NodeBase::nodeName() const -> const std::string& {
+  if (!name_.empty()) {
+    return name_;
+  }
+  // Not placed on an engine yet, the name is computed on every call as it might still change.
+  provisional_name_ = nodeName(enginePrefix());
+  return provisional_name_;
+}
+
+auto NodeBase::hashName(std::string_view name) -> std::uint64_t {
+  // 64 bit FNV-1a, unlike `std::hash` it yields the same value in every process and on every platform.
+  static constexpr std::uint64_t OFFSET_BASIS = 14695981039346656037ULL;
+  static constexpr std::uint64_t PRIME = 1099511628211ULL;
+  std::uint64_t hash = OFFSET_BASIS;
+  for (const char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= PRIME;
   }
-  return nodeName(engine_->prefix());
+  return hash;
+}
+
+void NodeBase::initializeNames() {
+  name_ = nodeName(enginePrefix());
+  id_ = hashName(name_);
+  metric_component_ = fmt::format("conduit/{}", name_);
+  telemetry_context_ = { .robot_name = enginePrefix(), .module = nodeName("") };
 }
 
 auto NodeBase::operationStart(bool has_period) -> ClockT::time_point {
@@ -33,9 +58,22 @@ auto NodeBase::operationStart(bool has_period) -> ClockT::time_point {
   if (iteration_ == 0) {
     start_time_ = ClockT::now();
   }
+  scheduled_start_ = has_period ? start_at : ClockT::time_point{};
   return start_at;
 }
 
+void NodeBase::operationTriggered() {
+  triggered_at_ = ClockT::now();
+}
+
+void NodeBase::executionStarted() {
+  const auto now = ClockT::now();
+  statistics_.start_latency.add(now - triggered_at_);
+  if (scheduled_start_ != ClockT::time_point{}) {
+    statistics_.period_jitter.add(now - scheduled_start_);
+  }
+}
+
 void NodeBase::operationEnd() {
   auto steady_now = std::chrono::steady_clock::now();
   auto system_now = std::chrono::system_clock::now();
@@ -51,29 +89,178 @@ void NodeBase::operationEnd() {
         ClockT::now() - (start_time_ + (iteration_ * period)));
   }
 
-  if (iteration_ > 0) {
-    heph::telemetry::record([name = nodeName(), timestamp = system_now,
-                             last_execution_duration = last_execution_duration_, tick_duration, clock_drift,
-                             period_drift] {
+  // Recording a metric allocates, the timings are buffered and recorded once per statistics period.
+  if (iteration_ > 0 && heph::telemetry::hasMetricSinks()) {
+    if (timing_samples_.capacity() == 0) {
+      timing_samples_.reserve(MAX_TIMING_SAMPLES);
+    }
+    timing_samples_.push_back({ .timestamp = system_now,
+                                .execute_duration = last_execution_duration_,
+                                .tick_duration = tick_duration,
+                                .clock_drift = clock_drift,
+                                .period_drift = period_drift });
+    if (timing_samples_.size() == MAX_TIMING_SAMPLES) {
+      exportTimings();
+    }
+  }
+  ++statistics_.executions;
+  const auto now = ClockT::now();
+  if (scheduled_start_ != ClockT::time_point{}) {
+    const auto deadline = scheduled_start_ + std::chrono::duration_cast<ClockT::duration>(period);
+    statistics_.lateness.add(std::max(now - deadline, ClockT::duration{ 0 }));
+    if (now > deadline) {
+      ++statistics_.late_executions;
+    }
+  }
+  if (tracing_) {
+    recordPathLatency(now);
+  }
+  if (last_statistics_publish_ == ClockT::time_point{}) {
+    // The first period starts with the first execution.
+    last_statistics_publish_ = now;
+  } else if (now - last_statistics_publish_ >= STATISTICS_PERIOD) {
+    last_statistics_publish_ = now;
+    publishStatistics();
+  }
+  input_trace_ = {};
+  ++iteration_;
+}
+
+auto NodeBase::statistics() const -> NodeStatistics {
+  const std::scoped_lock lock{ published_statistics_mutex_ };
+  return published_statistics_;
+}
+
+void NodeBase::publishStatistics() {
+  {
+    const std::scoped_lock lock{ published_statistics_mutex_ };
+    published_statistics_ = statistics_;
+    published_statistics_.execution_time.merge(previous_statistics_.execution_time);
+    published_statistics_.start_latency.merge(previous_statistics_.start_latency);
+    published_statistics_.period_jitter.merge(previous_statistics_.period_jitter);
+    published_statistics_.lateness.merge(previous_statistics_.lateness);
+  }
+  // Advance the rolling window, the counters keep accumulating.
+  previous_statistics_ = statistics_;
+  statistics_.execution_time.reset();
+  statistics_.start_latency.reset();
+  statistics_.period_jitter.reset();
+  statistics_.lateness.reset();
+
+  if (!heph::telemetry::hasMetricSinks()) {
+    return;
+  }
+  exportTimings();
+  heph::telemetry::record([component = metric_component_, statistics = published_statistics_,
+                           timestamp = std::chrono::system_clock::now()] {
+    auto microseconds = [](std::chrono::nanoseconds duration) {
+      return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+    return heph::telemetry::Metric{
+      .component = component,
+      .tag = std::string{ NODE_STATISTICS_METRIC_TAG },
+      .timestamp = timestamp,
+      .values = { { "executions", static_cast<std::int64_t>(statistics.executions) },
+                  { "deadline_misses", static_cast<std::int64_t>(statistics.deadline_misses) },
+                  { "late_executions", static_cast<std::int64_t>(statistics.late_executions) },
+                  { "input_overflows", static_cast<std::int64_t>(statistics.input_overflows) },
+                  { "execution_p50_microsec", microseconds(statistics.execution_time.percentile(0.5)) },
+                  { "execution_p99_microsec", microseconds(statistics.execution_time.percentile(0.99)) },
+                  { "execution_max_microsec", microseconds(statistics.execution_time.max()) },
+                  { "start_latency_p99_microsec", microseconds(statistics.start_latency.percentile(0.99)) },
+                  { "period_jitter_p99_microsec", microseconds(statistics.period_jitter.percentile(0.99)) },
+                  { "lateness_p99_microsec", microseconds(statistics.lateness.percentile(0.99)) },
+                  { "lateness_max_microsec", microseconds(statistics.lateness.max()) } },
+    };
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  });
+  if (tracing_) {
+    exportPathLatencies();
+  }
+}
+
+void NodeBase::exportTimings() {
+  for (const auto& sample : timing_samples_) {
+    heph::telemetry::record([component = metric_component_, sample] {
+      auto microseconds = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+      };
       return heph::telemetry::Metric{
-        .component = fmt::format("conduit/{}", name),
+        .component = component,
         .tag = "node_timings",
+        .timestamp = sample.timestamp,
+        .values = { { "execute_duration_microsec", microseconds(sample.execute_duration) },
+                    { "tick_duration_microsec", microseconds(sample.tick_duration) },
+                    { "clock_drift_microsec", sample.clock_drift.count() },
+                    { "period_drift_microsec", sample.period_drift.count() } }
+      };
+    });
+  }
+  // Keeps the capacity, the buffer is reused for the next period.
+  timing_samples_.clear();
+}
+
+auto NodeBase::dataAge() const -> ClockT::duration {
+  if (!input_trace_.valid()) {
+    return ClockT::duration{ 0 };
+  }
+  return ClockT::now() - input_trace_.origin;
+}
+
+auto NodeBase::outputTrace() const -> TraceContext {
+  if (!tracing_) {
+    return {};
+  }
+  if (!input_trace_.valid()) {
+    // Nothing traced got consumed, the data originates from this node.
+    return { .origin = last_system_, .origin_node = id_, .hops = 0 };
+  }
+  return { .origin = input_trace_.origin,
+           .origin_node = input_trace_.origin_node,
+           .hops = input_trace_.hops + 1 };
+}
+
+void NodeBase::recordPathLatency(ClockT::time_point now) {
+  if (!input_trace_.valid()) {
+    return;
+  }
+  auto it = std::ranges::find_if(path_latencies_, [this](const PathLatency& path) {
+    return path.origin_node == input_trace_.origin_node;
+  });
+  if (it == path_latencies_.end()) {
+    it = path_latencies_.insert(path_latencies_.end(),
+                                PathLatency{ .origin_node = input_trace_.origin_node, .histogram = {} });
+  }
+  it->histogram.add(now - input_trace_.origin);
+}
+
+void NodeBase::exportPathLatencies() {
+  for (const auto& path : path_latencies_) {
+    heph::telemetry::record([component = metric_component_, origin_node = path.origin_node,
+                             histogram = path.histogram, timestamp = std::chrono::system_clock::now()] {
+      auto microseconds = [](std::chrono::nanoseconds duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+      };
+      return heph::telemetry::Metric{
+        .component = component,
+        .tag = std::string{ PATH_LATENCY_METRIC_TAG },
         .timestamp = timestamp,
-        .values = { { "execute_duration_microsec",
-                      std::chrono::duration_cast<std::chrono::microseconds>(last_execution_duration)
-                          .count() },
-                    { "tick_duration_microsec",
-                      std::chrono::duration_cast<std::chrono::microseconds>(tick_duration).count() },
-                    { "clock_drift_microsec", clock_drift.count() },
-                    { "period_drift_microsec", period_drift.count() } }
+        .values = { { "origin_node", static_cast<std::int64_t>(origin_node) },
+                    { "count", static_cast<std::int64_t>(histogram.count()) },
+                    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+                    { "p50_microsec", microseconds(histogram.percentile(0.5)) },
+                    { "p99_microsec", microseconds(histogram.percentile(0.99)) },
+                    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+                    { "max_microsec", microseconds(histogram.max()) } },
       };
     });
   }
-  ++iteration_;
 }
 
 void NodeBase::updateExecutionTime(std::chrono::nanoseconds duration) {
   last_execution_duration_ = duration;
+  statistics_.execution_time.add(duration);
 }
 
 auto NodeBase::nextStartTime(bool has_period) -> ClockT::time_point {
@@ -89,6 +276,7 @@ auto NodeBase::nextStartTime(bool has_period) -> ClockT::time_point {
     // reset start time to avoid errors propagating if the deadline miss was too large
     start_time_ = now;
     iteration_ = 0;
+    ++statistics_.deadline_misses;
 
     heph::log(heph::WARN, std::string{ MISSED_DEADLINE_WARNING }, "node", nodeName(), "period", period,
               "tick_duration", last_duration, "execution_duration", last_execution_duration_);
@@ -104,20 +292,21 @@ ExecutionStopWatch::~ExecutionStopWatch() noexcept {
 
 ExecutionStopWatch::ExecutionStopWatch(NodeBase* self)
   : self_(self), start_(std::chrono::high_resolution_clock::now()) {
+  self_->executionStarted();
 }
 
 auto NodeBase::getStopToken() -> stdexec::inplace_stop_token {
-  if (engine_ == nullptr) {
+  if (context_ == nullptr) {
     return stdexec::inplace_stop_token{};
   }
-  return engine_->getStopToken();
+  return context_->getStopToken();
 }
 
 auto NodeBase::scheduler() const -> concurrency::Context::Scheduler {
-  if (engine_ == nullptr) {
+  if (context_ == nullptr) {
     return { nullptr };
   }
-  return engine_->scheduler();
+  return context_->scheduler();
 }
 
 auto NodeBase::enginePrefix() const -> std::string {
@@ -128,9 +317,9 @@ auto NodeBase::enginePrefix() const -> std::string {
 }
 
 auto NodeBase::runsOnEngine() const -> bool {
-  if (engine_ == nullptr) {
+  if (context_ == nullptr) {
     return true;
   }
-  return engine_->isCurrent();
+  return context_->isCurrent();
 }
 }  // namespace heph::conduit::detail
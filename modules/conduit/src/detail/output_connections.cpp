@@ -5,13 +5,22 @@
 
 #include "hephaestus/conduit/detail/output_connections.h"
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <utility>
 
 #include <fmt/format.h>
+#include <stdexec/execution.hpp>
 
+#include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/concurrency/context.h"
+#include "hephaestus/conduit/detail/awaiter.h"
 #include "hephaestus/conduit/detail/node_base.h"
+#include "hephaestus/conduit/input.h"
 #include "hephaestus/conduit/node_engine.h"
+#include "hephaestus/telemetry/metrics/metric_record.h"
+#include "hephaestus/telemetry/metrics/metric_sink.h"
 
 namespace heph::conduit::detail {
 
@@ -27,8 +36,12 @@ auto OutputConnections::rawName() const -> std::string {
   return name_;
 }
 
+auto OutputConnections::currentTrace() const -> TraceContext {
+  return node_->outputTrace();
+}
+
 void OutputConnections::registerInputToEngine(std::string input_name, std::string input_type,
-                                              detail::NodeBase* node) {
+                                              detail::NodeBase* node, bool borrows) {
   if (node->enginePtr() == nullptr) {
     return;
   }
@@ -38,7 +51,7 @@ void OutputConnections::registerInputToEngine(std::string input_name, std::strin
           .name = std::move(input_name),
           .node_name = node->nodeName(),  // Include the node name for better identification
           .type = std::move(input_type),
-
+          .borrows = borrows,
       },
       .output = {
           .name = name_,
@@ -49,4 +62,111 @@ void OutputConnections::registerInputToEngine(std::string input_name, std::strin
   });
 }
 
+auto OutputConnections::propagateToInputs(const void* value, bool share) -> bool {
+  concurrency::Context* pending_context{ nullptr };
+  InputEntry* overflowed_entry{ nullptr };
+  blocked_entry_ = nullptr;
+  for (InputEntry& entry : inputs_) {
+    if (entry.generation != generation_) {
+      continue;
+    }
+    const bool is_local = entry.node->runsOnEngine();
+    if (entry.attempted) {
+      // Rejected earlier in this round, prefer waiting on an input of the current context.
+      if (overflowed_entry == nullptr || (is_local && !overflowed_entry->node->runsOnEngine())) {
+        overflowed_entry = &entry;
+      }
+      continue;
+    }
+    if (!is_local) {
+      if (pending_context == nullptr) {
+        pending_context = &entry.node->scheduler().context();
+      }
+      continue;
+    }
+    entry.attempted = true;
+    InputState state{ InputState::OK };
+    if (share && entry.share_value != nullptr) {
+      state = entry.share_value(entry.ptr, shared_value_, trace_);
+    } else {
+      state = entry.set_value(entry.ptr, value, trace_);
+    }
+    if (state == InputState::OK) {
+      ++entry.generation;
+    } else if (overflowed_entry == nullptr || !overflowed_entry->node->runsOnEngine()) {
+      overflowed_entry = &entry;
+    }
+  }
+
+  if (pending_context != nullptr) {
+    // Deliver to the inputs of the next context before waiting on any overflowing input.
+    next_context_ = pending_context;
+    return false;
+  }
+  if (overflowed_entry != nullptr) {
+    startNextRound(*overflowed_entry);
+    return false;
+  }
+  if (next_context_ != nullptr && !node_->runsOnEngine()) {
+    // Complete on the context of the producing node.
+    next_context_ = nullptr;
+    return false;
+  }
+
+  // Everything is propagated, now reset...
+  for (InputEntry& entry : inputs_) {
+    entry.attempted = false;
+  }
+  generation_++;
+  next_context_ = nullptr;
+  shared_value_.reset();
+  return true;
+}
+
+void OutputConnections::startNextRound(InputEntry& overflowed_entry) {
+  for (InputEntry& entry : inputs_) {
+    entry.attempted = false;
+  }
+  if (!overflowed_entry.node->runsOnEngine()) {
+    // The input needs to be retried from its own context.
+    next_context_ = &overflowed_entry.node->scheduler().context();
+    return;
+  }
+
+  blocked_entry_ = &overflowed_entry;
+  ++overflow_count_;
+  heph::telemetry::record([component = fmt::format("conduit/{}", name()),
+                           input = overflowed_entry.name(overflowed_entry.ptr),
+                           overflow_count = overflow_count_, timestamp = std::chrono::system_clock::now()] {
+    return heph::telemetry::Metric{
+      .component = component,
+      .tag = std::string{ INPUT_OVERFLOW_METRIC_TAG },
+      .timestamp = timestamp,
+      .values = { { "input", input }, { "overflow_count", static_cast<std::int64_t>(overflow_count) } },
+    };
+  });
+}
+
+auto OutputConnections::awaitSlot(SlotAwaiterBase* awaiter) -> bool {
+  if (blocked_entry_ == nullptr) {
+    return false;
+  }
+  blocked_entry_->await_slot(blocked_entry_->ptr, awaiter);
+  return true;
+}
+
+void OutputConnections::cancelAwaitSlot(SlotAwaiterBase* awaiter) {
+  if (blocked_entry_ != nullptr) {
+    blocked_entry_->cancel_await_slot(blocked_entry_->ptr, awaiter);
+  }
+}
+
+auto OutputConnections::nextStep(NodeEngine& engine) -> NextStepT {
+  SchedulerT scheduler{ next_context_ };
+  if (next_context_ == nullptr) {
+    scheduler = node_->enginePtr() != nullptr ? node_->scheduler() : heph::conduit::scheduler(engine);
+  }
+  return stdexec::continues_on(heph::concurrency::makeSenderExpression<OutputSlotWaitT>(this), scheduler);
+}
+
 }  // namespace heph::conduit::detail
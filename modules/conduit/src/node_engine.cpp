@@ -5,46 +5,205 @@
 #include "hephaestus/conduit/node_engine.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <ranges>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/base.h>
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/concurrency/context.h"
+#include "hephaestus/concurrency/io_ring/timer.h"
 #include "hephaestus/conduit/detail/node_base.h"
 #include "hephaestus/conduit/remote_node_handler.h"
+#include "hephaestus/error_handling/panic.h"
 #include "hephaestus/net/endpoint.h"
+#include "hephaestus/telemetry/log/log.h"
 
 namespace heph::conduit {
+namespace {
+auto createContexts(const NodeEngineConfig& config) -> std::vector<std::unique_ptr<concurrency::Context>> {
+  if (config.number_of_contexts == 0) {
+    panic("NodeEngine requires at least one context");
+  }
+  // The simulated clock is shared process wide and can only be advanced by a single context.
+  if (config.number_of_contexts > 1 &&
+      config.context_config.timer_options.clock_mode == concurrency::io_ring::ClockMode::SIMULATED) {
+    panic("Simulated clock mode only supports a single context, requested {}", config.number_of_contexts);
+  }
+  std::vector<std::unique_ptr<concurrency::Context>> contexts;
+  contexts.reserve(config.number_of_contexts);
+  for (std::uint32_t i = 0; i != config.number_of_contexts; ++i) {
+    contexts.push_back(std::make_unique<concurrency::Context>(config.context_config));
+  }
+  return contexts;
+}
+
+auto statisticsLabel(const NodeStatistics& statistics) -> std::string {
+  auto microseconds = [](std::chrono::nanoseconds duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  };
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  return fmt::format("\\nexecutions: {}, execution p50: {}us, p99: {}us, max: {}us"
+                     "\\nstart latency p99: {}us, period jitter p99: {}us"
+                     "\\ndeadline misses: {}, late executions: {}, lateness p99: {}us"
+                     "\\ninput overflows: {}",
+                     statistics.executions, microseconds(statistics.execution_time.percentile(0.5)),
+                     microseconds(statistics.execution_time.percentile(0.99)),
+                     microseconds(statistics.execution_time.max()),
+                     microseconds(statistics.start_latency.percentile(0.99)),
+                     microseconds(statistics.period_jitter.percentile(0.99)), statistics.deadline_misses,
+                     statistics.late_executions, microseconds(statistics.lateness.percentile(0.99)),
+                     statistics.input_overflows);
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+}  // namespace
 
 NodeEngine::NodeEngine(const NodeEngineConfig& config)
   : pool_(config.number_of_threads)
-  , context_(config.context_config)
+  , contexts_(createContexts(config))
   , prefix_(config.prefix)
-  , remote_node_handler_(context_, config.endpoints, exception_) {
+  , shared_memory_ring_capacity_(config.shared_memory_ring_capacity)
+  , tracing_(config.enable_tracing)
+  , fuse_linear_chains_(config.fuse_linear_chains)
+  , nodes_per_context_(contexts_.size(), 0)
+  , remote_node_handler_(mainContext(), config.endpoints, exception_, config.shared_memory_ring_capacity) {
 }
 
 void NodeEngine::run() {
+  if (fuse_linear_chains_) {
+    fuseLinearChains();
+  }
   remote_node_handler_.run();
-  try {
-    context_.run();
-  } catch (...) {
-    exception_ = std::current_exception();
+  // Tasks are only handed over safely between running contexts, no context starts processing
+  // before all of them are up.
+  std::latch started{ static_cast<std::ptrdiff_t>(contexts_.size()) };
+  auto on_start = [&started] { started.arrive_and_wait(); };
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(contexts_.size() - 1);
+    for (auto& context : contexts_ | std::views::drop(1)) {
+      threads.emplace_back([this, &context, &on_start] { runContext(*context, on_start); });
+    }
+    runContext(mainContext(), on_start);
   }
   remote_node_handler_.requestStop();
   scope_.request_stop();
   stdexec::sync_wait(scope_.on_empty());
+  {
+    // All contexts stopped, make the final numbers of the last period available.
+    const std::scoped_lock lock{ nodes_mutex_ };
+    for (auto& node : nodes_) {
+      node->publishStatistics();
+    }
+  }
   if (exception_) {
     std::rethrow_exception(exception_);
   }
 }
+
 void NodeEngine::requestStop() {
   pool_.request_stop();
-  context_.requestStop();
+  requestStopContexts();
+}
+
+void NodeEngine::runContext(concurrency::Context& context, const std::function<void()>& on_start) {
+  try {
+    context.run(on_start);
+  } catch (...) {
+    setException(std::current_exception());
+    requestStopContexts();
+  }
+}
+
+void NodeEngine::setException(std::exception_ptr exception) {
+  const std::scoped_lock lock{ exception_mutex_ };
+  if (exception_) {
+    try {
+      std::rethrow_exception(exception_);
+    } catch (std::exception& previous) {
+      heph::log(heph::ERROR, "Overriding previous exception", "exception", previous.what());
+    } catch (...) {
+      heph::log(heph::ERROR, "Overriding previous exception", "exception", "unknown");
+    }
+  }
+  exception_ = std::move(exception);
+}
+
+void NodeEngine::requestStopContexts() {
+  for (auto& context : contexts_) {
+    context->requestStop();
+  }
+}
+
+void NodeEngine::fuseLinearChains() {
+  const std::scoped_lock lock{ nodes_mutex_ };
+  auto connections_of = [this](const std::string& node_name, const std::string& output_name) {
+    return std::ranges::count_if(connection_specs_, [&](const ConnectionSpecification& spec) {
+      return spec.output.node_name == node_name && spec.output.name == output_name;
+    });
+  };
+  for (const auto& node : nodes_) {
+    const auto inputs = node->inputSpecs();
+    if (inputs.size() != 1 || !inputs.front().fusable ||
+        node->nodePeriod() != std::chrono::nanoseconds{ 0 }) {
+      continue;
+    }
+    const auto& input = inputs.front();
+    auto is_input = [&input](const ConnectionSpecification& spec) {
+      return spec.input.node_name == input.node_name && spec.input.name == input.name;
+    };
+    if (std::ranges::count_if(connection_specs_, is_input) != 1) {
+      continue;
+    }
+    const auto& producer_output = std::ranges::find_if(connection_specs_, is_input)->output;
+    // Explicit outputs are set while the producer executes, the consumer would execute nested in it.
+    if (producer_output.name != "output" || connections_of(producer_output.node_name, "output") != 1) {
+      continue;
+    }
+    auto producer = std::ranges::find_if(nodes_, [&producer_output](const auto& other) {
+      return other->nodeName() == producer_output.node_name;
+    });
+    if (producer == nodes_.end() || (*producer)->context_ != node->context_) {
+      continue;
+    }
+    node->fused_ = true;
+  }
+}
+
+auto NodeEngine::contextIndex(const detail::NodeBase& node) const -> std::size_t {
+  return node.context_index_;
+}
+
+void NodeEngine::makeNodeIdUnique(detail::NodeBase& node) {
+  const std::scoped_lock lock{ nodes_mutex_ };
+  auto taken = [this, &node](std::uint64_t id) {
+    return std::ranges::any_of(nodes_, [&node, id](const auto& other) {
+      return other.get() != &node && other->id_ == id;
+    });
+  };
+  for (std::size_t duplicate = 1; taken(node.id_); ++duplicate) {
+    node.id_ = detail::NodeBase::hashName(fmt::format("{}#{}", node.name_, duplicate));
+  }
+}
+
+auto NodeEngine::leastLoadedContext() const -> std::size_t {
+  const std::scoped_lock lock{ nodes_mutex_ };
+  return static_cast<std::size_t>(std::ranges::distance(nodes_per_context_.begin(),
+                                                        std::ranges::min_element(nodes_per_context_)));
 }
 
 auto NodeEngine::endpoints() const -> std::vector<heph::net::Endpoint> {
@@ -55,17 +214,51 @@ auto scheduler(NodeEngine& engine) -> concurrency::Context::Scheduler {
   return engine.scheduler();
 }
 
-auto NodeEngine::getDotGraph() const -> std::string {
+auto NodeEngine::getPathLatencies() const -> std::vector<PathLatency> {
+  const std::scoped_lock lock{ nodes_mutex_ };
+  std::unordered_map<std::uint64_t, std::string> names;
+  for (const auto& node : nodes_) {
+    names.emplace(node->nodeId(), node->nodeName());
+  }
+  std::vector<PathLatency> latencies;
+  for (const auto& node : nodes_) {
+    for (const auto& path : node->pathLatencies()) {
+      auto it = names.find(path.origin_node);
+      // Data received from remote engines originates from nodes we don't know.
+      latencies.push_back({ .origin = it != names.end() ? it->second : fmt::format("{:#x}", path.origin_node),
+                            .node = node->nodeName(),
+                            .histogram = path.histogram });
+    }
+  }
+  return latencies;
+}
+
+auto NodeEngine::getNodeStatistics() const -> std::unordered_map<std::uint64_t, NodeStatistics> {
+  const std::scoped_lock lock{ nodes_mutex_ };
+  std::unordered_map<std::uint64_t, NodeStatistics> statistics;
+  for (const auto& node : nodes_) {
+    statistics.emplace(node->nodeId(), node->statistics());
+  }
+  return statistics;
+}
+
+auto NodeEngine::getDotGraph(bool annotate_statistics) const -> std::string {
+  const std::scoped_lock lock{ nodes_mutex_ };
   fmt::println("Node: {}, connections: {}", nodes_.size(), connection_specs_.size());
 
+  // Overflows of the inputs by their qualified name, used to label the edges.
+  std::unordered_map<std::string, std::uint64_t> input_overflows;
   std::string dot_graph = "digraph {\n";
   std::size_t counter = 0;
   for (const auto& node : nodes_) {
     dot_graph += fmt::format("  subgraph cluster_{} {{\n", counter++);
-    dot_graph += fmt::format("    label=\"{}\";\n", node->nodeName());
+    dot_graph += fmt::format("    label=\"{}{}\";\n", node->nodeName(),
+                             annotate_statistics ? statisticsLabel(node->statistics()) : "");
     for (const auto& input : node->inputSpecs()) {
-      dot_graph += fmt::format("    {}__{} [label=\"{}\", shape=ellipse, color=green];\n", input.node_name,
-                               input.name, input.name);
+      input_overflows[fmt::format("{}__{}", input.node_name, input.name)] = input.overflows;
+      // Borrowing inputs only hold a shared handle to the output value and are drawn dashed
+      dot_graph += fmt::format("    {}__{} [label=\"{}\", shape=ellipse, color=green{}];\n", input.node_name,
+                               input.name, input.name, input.borrows ? ", style=dashed" : "");
     }
 
     for (const auto& output : node->outputSpecs()) {
@@ -77,8 +270,17 @@ auto NodeEngine::getDotGraph() const -> std::string {
   }
 
   for (const auto& spec : connection_specs_) {
-    dot_graph += fmt::format("  {}__{} -> {}__{};\n", spec.output.node_name, spec.output.name,
-                             spec.input.node_name, spec.input.name);
+    std::vector<std::string> attributes;
+    if (spec.input.borrows) {
+      attributes.emplace_back("style=dashed");
+    }
+    if (annotate_statistics) {
+      const auto overflows = input_overflows[fmt::format("{}__{}", spec.input.node_name, spec.input.name)];
+      attributes.push_back(fmt::format("label=\"overflows: {}\"", overflows));
+    }
+    dot_graph += fmt::format("  {}__{} -> {}__{}{};\n", spec.output.node_name, spec.output.name,
+                             spec.input.node_name, spec.input.name,
+                             attributes.empty() ? "" : fmt::format(" [{}]", fmt::join(attributes, ", ")));
   }
 
   dot_graph += "}\n";
@@ -0,0 +1,22 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include "hephaestus/conduit/parallel_for.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace heph::conduit::detail {
+auto parallelForChunks(std::size_t size, std::size_t parallelism, const ParallelForOptions& options)
+    -> std::size_t {
+  if (size == 0) {
+    return 0;
+  }
+  const auto min_chunk_size = std::max<std::size_t>(options.min_chunk_size, 1);
+  const auto chunks_by_size = (size + min_chunk_size - 1) / min_chunk_size;
+  const auto chunks_by_threads =
+      std::max<std::size_t>(parallelism, 1) * std::max<std::size_t>(options.chunks_per_thread, 1);
+  return std::min({ chunks_by_size, chunks_by_threads, PARALLEL_FOR_MAX_CHUNKS });
+}
+}  // namespace heph::conduit::detail
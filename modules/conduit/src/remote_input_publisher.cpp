@@ -4,24 +4,22 @@
 
 #include "hephaestus/conduit/remote_input_publisher.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <exception>
-#include <span>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include <exec/task.hpp>
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/conduit/remote_nodes.h"
 #include "hephaestus/error_handling/panic.h"
-#include "hephaestus/net/recv.h"
 #include "hephaestus/net/socket.h"
 #include "hephaestus/telemetry/log/log.h"
 
 namespace heph::conduit::internal {
-auto SetRemoteInputOperator::execute(std::vector<std::byte> msg, std::string* type_info) -> exec::task<bool> {
+auto SetRemoteInputOperator::execute(TracedMessage msg, std::string* type_info) -> exec::task<bool> {
   try {
     if (!socket_.has_value()) {
       socket_.emplace(internal::createNetEntity<heph::net::Socket>(endpoint_, *context_));
@@ -30,15 +28,56 @@ auto SetRemoteInputOperator::execute(std::vector<std::byte> msg, std::string* ty
       if (error != CONNECT_SUCCESS) {
         heph::panic("Could not connect: {}", error);
       }
+      writer_.reset();
+      window_.reset();
+      in_flight_ = 0;
+      if (type_.datagram) {
+        datagram_socket_.emplace(co_await internal::openDatagramSender(*socket_));
+        datagram_writer_.reset();
+      }
+    }
+
+    if (type_.datagram) {
+      if (internal::peerClosed(socket_.value())) {
+        heph::log(heph::ERROR, "Reconnecting, connection was closed", "node", name());
+        socket_.reset();
+        co_return true;
+      }
+      co_await (internal::sendMsg(datagram_writer_, datagram_socket_.value(), name(), msg) |
+                stdexec::upon_stopped([this] { socket_.reset(); }));
+      co_return true;
+    }
+
+    if (!type_.reliable) {
+      co_await (internal::sendMsg(writer_, socket_.value(), name(), msg) |
+                stdexec::upon_stopped([this] { socket_.reset(); }));
+      co_return true;
+    }
+
+    // Keep at most a window of messages while the connection is broken, dropping the oldest.
+    while (unacked_.size() >= std::max<std::size_t>(type_.window, 1)) {
+      unacked_.pop_front();
+      in_flight_ = std::min(in_flight_, unacked_.size());
     }
+    unacked_.push_back(std::move(msg));
 
-    co_await (internal::sendMsg(socket_.value(), name(), std::move(msg)) |
-              stdexec::upon_stopped([this] { socket_.reset(); }));
-    if (type_.reliable) {
-      std::byte ack{};
-      co_await ((heph::net::recvAll(socket_.value(), std::span<std::byte>{ &ack, 1 }) |
-                 stdexec::then([](std::span<std::byte> /*unused*/) {})) |
+    while (in_flight_ != unacked_.size()) {
+      co_await (internal::sendMsg(writer_, socket_.value(), name(), unacked_[in_flight_]) |
                 stdexec::upon_stopped([this] { socket_.reset(); }));
+      if (!socket_.has_value()) {
+        // Lost the connection, the unacknowledged messages are sent again after reconnecting.
+        break;
+      }
+      ++in_flight_;
+      const auto acknowledged = co_await (window_.sent(socket_.value()) | stdexec::upon_stopped([this] {
+                                            socket_.reset();
+                                            return std::size_t{ 0 };
+                                          }));
+      if (!socket_.has_value()) {
+        break;
+      }
+      unacked_.erase(unacked_.begin(), unacked_.begin() + static_cast<std::ptrdiff_t>(acknowledged));
+      in_flight_ -= acknowledged;
     }
 
   } catch (std::exception& exception) {
@@ -33,8 +33,8 @@ namespace heph::conduit {
 
 RemoteNodeHandler::RemoteNodeHandler(concurrency::Context& context,
                                      const std::vector<heph::net::Endpoint>& endpoints,
-                                     std::exception_ptr& exception)
-  : exception_(exception) {
+                                     std::exception_ptr& exception, std::size_t shared_memory_ring_capacity)
+  : exception_(exception), shared_memory_ring_capacity_(shared_memory_ring_capacity) {
   acceptors_.reserve(endpoints.size());
 
   auto create_acceptor = [&](net::EndpointType type) {
@@ -47,6 +47,8 @@ RemoteNodeHandler::RemoteNodeHandler(concurrency::Context& context,
         return heph::net::Acceptor::createTcpIpV4(context);
       case heph::net::EndpointType::IPV6:
         return heph::net::Acceptor::createTcpIpV6(context);
+      case heph::net::EndpointType::IPC:
+        return heph::net::Acceptor::createUnix(context);
       default:
         heph::panic("Unknown endpoint type");
     }
@@ -132,6 +134,9 @@ auto RemoteNodeHandler::handleClient(heph::net::Socket client, RemoteNodeType ty
   //
   // 2. Value loop:
   //  1. Send Data
+  //
+  // Datagram connections announce the port of the receiving datagram socket (uint16_t) right after the
+  // negotiation, values are then sent as datagrams while the stream connection stays idle.
   try {
     auto [name, type_info] = co_await recvNameInfo(&client);
 
@@ -153,11 +158,18 @@ auto RemoteNodeHandler::handleClient(heph::net::Socket client, RemoteNodeType ty
       co_return;
     }
 
+    if (type.datagram && client.type() == heph::net::SocketType::UNIX) {
+      const std::string error = "Datagram connections need an IP endpoint";
+      heph::log(heph::ERROR, error, "name", name, "client", client.remoteEndpoint());
+      co_await internal::send(client, error);
+      co_return;
+    }
+
     co_await internal::send(client, CONNECT_SUCCESS);
 
     heph::log(heph::INFO, "Client connected", "name", name, "type", type_string, "reliable", type.reliable,
-              "client", client.remoteEndpoint());
-    entry.factory(std::move(client), type.reliable);
+              "window", type.window, "datagram", type.datagram, "client", client.remoteEndpoint());
+    entry.factory(std::move(client), type);
   } catch (std::exception& exception) {
     heph::log(heph::ERROR, "Output subscriber disconnected", "exception", exception.what());
   }
@@ -6,7 +6,6 @@
 
 #include <cstddef>
 #include <exception>
-#include <span>
 #include <string>
 #include <vector>
 
@@ -16,7 +15,6 @@
 #include "hephaestus/concurrency/context.h"
 #include "hephaestus/conduit/remote_nodes.h"
 #include "hephaestus/error_handling/panic.h"
-#include "hephaestus/net/send.h"
 #include "hephaestus/net/socket.h"
 #include "hephaestus/telemetry/log/log.h"
 
@@ -26,20 +24,29 @@ auto RemoteSubscriberOperator::trigger(heph::concurrency::Context* context, std:
   try {
     if (!socket_.has_value()) {
       socket_.emplace(internal::createNetEntity<heph::net::Socket>(endpoint_, *context));
+      reader_.reset();
+      acknowledger_.reset();
 
       auto error = co_await internal::connect(*socket_, endpoint_, *type_info, type_, name_);
       if (error != CONNECT_SUCCESS) {
         heph::panic("Could not connect: {}", error);
       }
+      if (type_.datagram) {
+        datagram_socket_.emplace(co_await internal::openDatagramReceiver(*socket_));
+        datagram_reader_.reset();
+      }
     }
 
-    auto msg = co_await (internal::recv<std::pmr::vector<std::byte>>(socket_.value(), &memory_resource_) |
-                         stdexec::upon_stopped([] { return std::pmr::vector<std::byte>{}; }));
-    if (type_.reliable) {
-      std::byte ack{};
-      co_await ((heph::net::sendAll(socket_.value(), std::span{ &ack, 1 }) |
-                 stdexec::then([](std::span<const std::byte> /*unused*/) {})) |
-                stdexec::upon_stopped([&] { msg.clear(); }));
+    MsgT msg{ &memory_resource_ };
+    if (type_.datagram) {
+      co_await (
+          internal::readDatagram(datagram_reader_, datagram_socket_.value(), socket_.value(), msg.buffer) |
+          stdexec::upon_stopped([&msg] { msg.clear(); }));
+    } else {
+      co_await (reader_.read(socket_.value(), msg) | stdexec::upon_stopped([&msg] { msg.clear(); }));
+    }
+    if (type_.reliable && !msg.empty()) {
+      co_await (acknowledger_.received(socket_.value()) | stdexec::upon_stopped([&] { msg.clear(); }));
     }
     if (!msg.empty()) {
       co_return msg;
@@ -63,7 +70,8 @@ auto RemoteSubscriberOperator::trigger(heph::concurrency::Context* context, std:
     }
   }
 
+  datagram_socket_.reset();
   socket_.reset();
-  co_return {};
+  co_return MsgT{ &memory_resource_ };
 }
 }  // namespace heph::conduit::internal
@@ -0,0 +1,5 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include "hephaestus/conduit/synchronized_input.h"
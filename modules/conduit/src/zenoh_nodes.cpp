@@ -3,3 +3,50 @@
 //=================================================================================================
 
 #include "hephaestus/conduit/zenoh_nodes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "hephaestus/telemetry/metrics/metric_record.h"
+#include "hephaestus/telemetry/metrics/metric_sink.h"
+
+namespace heph::conduit::internal {
+namespace {
+auto policyName(SubscriberOverflowPolicy policy) -> std::string_view {
+  switch (policy) {
+    case SubscriberOverflowPolicy::DROP_NEWEST:
+      return "drop_newest";
+    case SubscriberOverflowPolicy::DROP_OLDEST:
+      return "drop_oldest";
+    case SubscriberOverflowPolicy::WAIT:
+      return "wait";
+  }
+  return "unknown";
+}
+}  // namespace
+
+void recordSubscriberOverflow(const std::string& topic, SubscriberOverflowPolicy policy,
+                              const ZenohSubscriberStatistics& statistics) {
+  // Building the metric allocates, skip it if nobody is listening.
+  if (!heph::telemetry::hasMetricSinks()) {
+    return;
+  }
+  heph::telemetry::record([component = fmt::format("conduit/zenoh_subscriber/{}", topic),
+                           policy = std::string{ policyName(policy) }, statistics,
+                           timestamp = std::chrono::system_clock::now()] {
+    return heph::telemetry::Metric{
+      .component = component,
+      .tag = std::string{ SUBSCRIBER_OVERFLOW_METRIC_TAG },
+      .timestamp = timestamp,
+      .values = { { "policy", policy },
+                  { "received", static_cast<std::int64_t>(statistics.received) },
+                  { "waited", static_cast<std::int64_t>(statistics.waited) },
+                  { "dropped", static_cast<std::int64_t>(statistics.dropped) } },
+    };
+  });
+}
+}  // namespace heph::conduit::internal
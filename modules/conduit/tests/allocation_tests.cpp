@@ -0,0 +1,166 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+
+#include <gtest/gtest.h>
+#include <stdexec/execution.hpp>
+
+#include "hephaestus/concurrency/io_ring/timer.h"
+#include "hephaestus/conduit/input.h"
+#include "hephaestus/conduit/node.h"
+#include "hephaestus/conduit/node_engine.h"
+#include "hephaestus/conduit/queued_input.h"
+#include "hephaestus/telemetry/metrics/metric_record.h"
+#include "hephaestus/telemetry/metrics/metric_sink.h"
+
+// The global allocation functions are replaced to count the heap allocations of each thread. Only
+// the unaligned variants are replaced, the default implementations of all others forward to them.
+namespace {
+thread_local std::size_t
+    allocation_count{ 0 };  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+
+auto operator new(std::size_t size) -> void* {
+  ++allocation_count;
+  // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+  if (void* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
+
+namespace heph::conduit::tests {
+namespace {
+/// Counts the heap allocations performed by the current thread since the counter was reset.
+class AllocationCounter {
+public:
+  void reset() {
+    start_ = allocation_count;
+  }
+
+  [[nodiscard]] auto count() const -> std::size_t {
+    return allocation_count - start_;
+  }
+
+private:
+  std::size_t start_{ allocation_count };
+};
+
+// Iterations to reach the steady state, e.g. for the timer to reach its final capacity.
+constexpr std::size_t WARMUP_ITERATIONS = 10;
+constexpr std::size_t MEASURED_ITERATIONS = 100;
+
+auto simulatedEngineConfig() -> NodeEngineConfig {
+  return { .context_config = { .io_ring_config = {},
+                               .timer_options = { concurrency::io_ring::ClockMode::SIMULATED } },
+           .prefix = "allocation",
+           .endpoints = {} };
+}
+
+struct MeasurementData {
+  std::size_t iteration{ 0 };
+  AllocationCounter counter;
+  std::optional<std::size_t> allocations;
+};
+
+/// Measures the allocations between the executions once the node reached the steady state.
+template <typename NodeT>
+void measure(NodeT& self) {
+  auto& data = self.data();
+  ++data.iteration;
+  if (data.iteration == WARMUP_ITERATIONS) {
+    data.counter.reset();
+  }
+  if (data.iteration == WARMUP_ITERATIONS + MEASURED_ITERATIONS) {
+    data.allocations.emplace(data.counter.count());
+    self.engine().requestStop();
+  }
+}
+}  // namespace
+
+struct PeriodicOperation : Node<PeriodicOperation, MeasurementData> {
+  static constexpr auto PERIOD = std::chrono::milliseconds{ 1 };
+
+  static void execute(PeriodicOperation& self) {
+    measure(self);
+  }
+};
+
+TEST(AllocationTests, periodicNode) {
+  NodeEngine engine{ simulatedEngineConfig() };
+  auto node = engine.createNode<PeriodicOperation>();
+
+  engine.run();
+  ASSERT_TRUE(node->data().allocations.has_value());
+  EXPECT_EQ(*node->data().allocations, 0);
+}
+
+/// Consumes the metrics without looking at them, enables recording the node metrics.
+class NullMetricSink final : public telemetry::IMetricSink {
+public:
+  void send(const telemetry::Metric& /*metric*/) final {
+  }
+};
+
+TEST(AllocationTests, periodicNodeWithMetricSink) {
+  // Sinks cannot be unregistered, the tests following this one run with the sink registered as well.
+  telemetry::registerMetricSink(std::make_unique<NullMetricSink>());
+
+  NodeEngine engine{ simulatedEngineConfig() };
+  auto node = engine.createNode<PeriodicOperation>();
+
+  engine.run();
+  ASSERT_TRUE(node->data().allocations.has_value());
+  EXPECT_EQ(*node->data().allocations, 0);
+}
+
+struct ProducerData {
+  std::size_t value{ 0 };
+};
+
+struct Producer : Node<Producer, ProducerData> {
+  static constexpr auto PERIOD = std::chrono::milliseconds{ 1 };
+
+  static auto execute(Producer& self) -> std::size_t {
+    return self.data().value++;
+  }
+};
+
+struct Consumer : Node<Consumer, MeasurementData> {
+  QueuedInput<std::size_t, InputPolicy<1>> input{ this, "input" };
+
+  static auto trigger(Consumer& self) {
+    return self.input.get();
+  }
+
+  static void execute(Consumer& self, std::size_t /*value*/) {
+    measure(self);
+  }
+};
+
+TEST(AllocationTests, connectedNodes) {
+  NodeEngine engine{ simulatedEngineConfig() };
+  auto producer = engine.createNode<Producer>();
+  auto consumer = engine.createNode<Consumer>();
+  consumer->input.connectTo(producer);
+
+  engine.run();
+  ASSERT_TRUE(consumer->data().allocations.has_value());
+  EXPECT_EQ(*consumer->data().allocations, 0);
+}
+}  // namespace heph::conduit::tests
@@ -0,0 +1,572 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+// Runs reference graphs on the node engine and reports per edge latencies, node throughput, deadline
+// misses, execution and CPU times as JSON. The graphs are executed with the simulated and the wall clock
+// to catch regressions in the propagation and scheduling paths, e.g. `OutputConnections`, the input
+// awaiters and the concurrency context.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/base.h>
+#include <fmt/format.h>
+#include <rfl/json/write.hpp>
+
+#include "hephaestus/cli/program_options.h"
+#include "hephaestus/concurrency/io_ring/timer.h"
+#include "hephaestus/conduit/detail/node_base.h"
+#include "hephaestus/conduit/input.h"
+#include "hephaestus/conduit/node.h"
+#include "hephaestus/conduit/node_engine.h"
+#include "hephaestus/conduit/node_handle.h"
+#include "hephaestus/conduit/queued_input.h"
+#include "hephaestus/telemetry/log/log.h"
+#include "hephaestus/telemetry/log/log_sink.h"
+
+namespace conduit_benchmark {
+using SteadyClockT = std::chrono::steady_clock;
+using heph::concurrency::io_ring::ClockMode;
+
+/// Payload exchanged on every edge, stamped when the producer finished its execution.
+struct Message {
+  SteadyClockT::time_point sent;
+};
+
+struct EdgeStatistics {
+  std::string name;
+  std::vector<std::chrono::nanoseconds> latencies;
+};
+
+struct NodeStatistics {
+  std::string name;
+  std::size_t executions{ 0 };
+  std::chrono::nanoseconds execution_time{ 0 };
+  std::chrono::nanoseconds cpu_time{ 0 };
+};
+
+struct EdgeReport {
+  std::string name;
+  std::size_t samples;
+  double p50_us;
+  double p90_us;
+  double p99_us;
+  double max_us;
+};
+
+struct NodeReport {
+  std::string name;
+  std::size_t executions;
+  double throughput_hz;
+  double execution_time_us;
+  /// Fraction of the wall time of the run spent executing the node. This is not a CPU time share, the
+  /// execution is timed with the wall clock and includes the time the thread got preempted.
+  double wall_time_share;
+  /// CPU time of the thread spent executing the node.
+  double cpu_time_us;
+  /// Fraction of the CPU time of the process, `process_cpu_s`, spent executing the node.
+  double cpu_share;
+  std::size_t deadline_misses;
+};
+
+struct RunReport {
+  std::string graph;
+  std::string clock_mode;
+  double engine_time_s;
+  double wall_time_s;
+  double process_cpu_s;
+  std::vector<NodeReport> nodes;
+  std::vector<EdgeReport> edges;
+};
+
+/// Counts the deadline misses reported by the engine per node.
+class DeadlineMissSink final : public heph::telemetry::ILogSink {
+public:
+  void send(const heph::telemetry::LogEntry& entry) override {
+    using heph::conduit::detail::NodeBase;
+    if (entry.level != heph::WARN || entry.message != NodeBase::MISSED_DEADLINE_WARNING) {
+      return;
+    }
+    auto it = std::ranges::find_if(entry.fields, [](const auto& field) { return field.key == "node"; });
+    if (it == entry.fields.end()) {
+      return;
+    }
+    const std::scoped_lock lock{ mutex_ };
+    ++misses_[it->value];
+  }
+
+  [[nodiscard]] auto misses(const std::string& node_name) -> std::size_t {
+    const std::scoped_lock lock{ mutex_ };
+    // Strings are quoted in log fields.
+    auto it = misses_.find(fmt::format("{:?}", node_name));
+    return it == misses_.end() ? 0 : it->second;
+  }
+
+  void reset() {
+    const std::scoped_lock lock{ mutex_ };
+    misses_.clear();
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::size_t> misses_;
+};
+
+struct BenchmarkConfig {
+  std::chrono::milliseconds duration;
+  std::chrono::microseconds work;
+  std::size_t number_of_contexts;
+};
+
+/// Statistics of a single benchmark run. Statistics of a node are only touched from the context of the
+/// node, edges from the context of the consuming node.
+class Run {
+public:
+  explicit Run(const BenchmarkConfig& config) : config_(config) {
+  }
+
+  auto addNode(std::string name) -> NodeStatistics* {
+    return &nodes_.emplace_back(NodeStatistics{ .name = std::move(name) });
+  }
+
+  auto addEdge(std::string name) -> EdgeStatistics* {
+    return &edges_.emplace_back(EdgeStatistics{ .name = std::move(name), .latencies = {} });
+  }
+
+  [[nodiscard]] auto config() const -> const BenchmarkConfig& {
+    return config_;
+  }
+
+  [[nodiscard]] auto nodes() const -> const std::deque<NodeStatistics>& {
+    return nodes_;
+  }
+
+  [[nodiscard]] auto edges() -> std::deque<EdgeStatistics>& {
+    return edges_;
+  }
+
+private:
+  BenchmarkConfig config_;
+  // Deques to keep the statistics at stable addresses.
+  std::deque<NodeStatistics> nodes_;
+  std::deque<EdgeStatistics> edges_;
+};
+
+/// CPU time consumed so far by the calling thread, unlike the steady clock it excludes preemptions.
+auto threadCpuTime() -> std::chrono::nanoseconds {
+  timespec time{};
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return std::chrono::seconds{ time.tv_sec } + std::chrono::nanoseconds{ time.tv_nsec };
+}
+
+/// Start of an execution, taken first thing in the execute function of the node.
+struct ExecutionStart {
+  SteadyClockT::time_point steady{ SteadyClockT::now() };
+  std::chrono::nanoseconds cpu{ threadCpuTime() };
+};
+
+struct StageData {
+  StageData(std::string name_in, std::chrono::nanoseconds period_in, Run& run)
+    : name(std::move(name_in)), period(period_in), work(run.config().work), statistics(run.addNode(name)) {
+  }
+
+  /// Records the latency of a message received on the given edge.
+  static void consume(EdgeStatistics* edge, const Message& message, SteadyClockT::time_point now) {
+    if (edge != nullptr) {
+      edge->latencies.push_back(now - message.sent);
+    }
+  }
+
+  /// Simulates the workload of the node and stamps the produced message.
+  auto produce(const ExecutionStart& start) -> Message {
+    while (SteadyClockT::now() - start.steady < work) {
+    }
+    auto end = SteadyClockT::now();
+    ++statistics->executions;
+    statistics->execution_time += end - start.steady;
+    statistics->cpu_time += threadCpuTime() - start.cpu;
+    return Message{ .sent = end };
+  }
+
+  std::string name;
+  std::chrono::nanoseconds period;
+  std::chrono::nanoseconds work;
+  NodeStatistics* statistics;
+};
+
+using TriggerInputT = heph::conduit::QueuedInput<Message>;
+using PolledInputT =
+    heph::conduit::QueuedInput<Message, heph::conduit::InputPolicy<1, heph::conduit::RetrievalMethod::POLL,
+                                                                   heph::conduit::SetMethod::OVERWRITE>>;
+
+template <typename NodeT, std::size_t... Is>
+auto makePolledInputs(NodeT* node, std::index_sequence<Is...> /*indices*/)
+    -> std::array<PolledInputT, sizeof...(Is)> {
+  return { PolledInputT{ node, fmt::format("polled{}", Is) }... };
+}
+
+/// Consumes the latest values of the polled inputs, if they got updated since the last execution.
+template <std::size_t N>
+void consumePolled(std::array<PolledInputT, N>& inputs, const std::array<EdgeStatistics*, N>& edges,
+                   SteadyClockT::time_point now) {
+  for (std::size_t i = 0; i != N; ++i) {
+    if (auto message = inputs[i].getValue(); message.has_value()) {
+      StageData::consume(edges[i], *message, now);
+    }
+  }
+}
+
+auto edgeName(const heph::conduit::detail::NodeBase& producer,
+              const heph::conduit::detail::NodeBase& consumer, std::string_view topic) -> std::string {
+  return fmt::format("{}->{}/{}", producer.nodeName(), consumer.nodeName(), topic);
+}
+
+/// Periodic node without inputs.
+struct Source : heph::conduit::Node<Source, StageData> {
+  static auto name(const Source& self) -> std::string {
+    return self.data().name;
+  }
+
+  static auto period(const Source& self) -> std::chrono::nanoseconds {
+    return self.data().period;
+  }
+
+  static auto execute(Source& self) -> Message {
+    return self.data().produce(ExecutionStart{});
+  }
+};
+
+/// Node triggered by a single input, additionally polling the latest values of `NumPolled` inputs.
+template <std::size_t NumPolled>
+struct Relay : heph::conduit::Node<Relay<NumPolled>, StageData> {
+  TriggerInputT input{ this, "input" };
+  std::array<PolledInputT, NumPolled> polled{ makePolledInputs(this, std::make_index_sequence<NumPolled>{}) };
+  EdgeStatistics* input_edge{ nullptr };
+  std::array<EdgeStatistics*, NumPolled> polled_edges{};
+
+  static auto name(const Relay& self) -> std::string {
+    return self.data().name;
+  }
+
+  static auto trigger(Relay& self) {
+    return self.input.get();
+  }
+
+  static auto execute(Relay& self, const Message& message) -> Message {
+    const ExecutionStart start;
+    StageData::consume(self.input_edge, message, start.steady);
+    consumePolled(self.polled, self.polled_edges, start.steady);
+    return self.data().produce(start);
+  }
+
+  template <typename ProducerT>
+  void connectInput(Run& run, heph::conduit::NodeHandle<ProducerT>& producer, std::string_view topic) {
+    input.connectTo(producer);
+    input_edge = run.addEdge(edgeName(*producer, *this, topic));
+  }
+
+  template <typename ProducerT>
+  void connectPolled(Run& run, std::size_t index, heph::conduit::NodeHandle<ProducerT>& producer,
+                     std::string_view topic) {
+    polled.at(index).connectTo(producer);
+    polled_edges.at(index) = run.addEdge(edgeName(*producer, *this, topic));
+  }
+};
+
+/// Periodic node sampling the latest values of `NumPolled` inputs.
+template <std::size_t NumPolled>
+struct Sampler : heph::conduit::Node<Sampler<NumPolled>, StageData> {
+  std::array<PolledInputT, NumPolled> polled{ makePolledInputs(this, std::make_index_sequence<NumPolled>{}) };
+  std::array<EdgeStatistics*, NumPolled> polled_edges{};
+
+  static auto name(const Sampler& self) -> std::string {
+    return self.data().name;
+  }
+
+  static auto period(const Sampler& self) -> std::chrono::nanoseconds {
+    return self.data().period;
+  }
+
+  static auto execute(Sampler& self) -> Message {
+    const ExecutionStart start;
+    consumePolled(self.polled, self.polled_edges, start.steady);
+    return self.data().produce(start);
+  }
+
+  template <typename ProducerT>
+  void connectPolled(Run& run, std::size_t index, heph::conduit::NodeHandle<ProducerT>& producer,
+                     std::string_view topic) {
+    polled.at(index).connectTo(producer);
+    polled_edges.at(index) = run.addEdge(edgeName(*producer, *this, topic));
+  }
+};
+
+/// Stops the engine once the configured duration elapsed on the engine clock.
+struct Timeout : heph::conduit::Node<Timeout, std::chrono::milliseconds> {
+  static constexpr auto NAME = "timeout";
+  static constexpr auto PERIOD = std::chrono::milliseconds{ 10 };
+
+  static void execute(Timeout& self) {
+    if (self.engine().elapsed() > self.data()) {
+      self.engine().requestStop();
+    }
+  }
+};
+
+constexpr auto MS = std::chrono::milliseconds{ 1 };
+constexpr auto SYNTHETIC_PERIOD = MS;
+constexpr std::size_t CHAIN_LENGTH = 10;
+constexpr std::size_t FAN_OUT_WIDTH = 10;
+constexpr std::size_t FAN_IN_WIDTH = 4;
+
+void createChain(heph::conduit::NodeEngine& engine, Run& run) {
+  auto source = engine.createNode<Source>("source", SYNTHETIC_PERIOD, run);
+  auto previous = engine.createNode<Relay<0>>("stage0", std::chrono::nanoseconds{}, run);
+  previous->connectInput(run, source, "chain");
+  for (std::size_t i = 1; i != CHAIN_LENGTH; ++i) {
+    auto stage = engine.createNode<Relay<0>>(fmt::format("stage{}", i), std::chrono::nanoseconds{}, run);
+    stage->connectInput(run, previous, "chain");
+    previous = stage;
+  }
+}
+
+void createFanOut(heph::conduit::NodeEngine& engine, Run& run) {
+  auto source = engine.createNode<Source>("source", SYNTHETIC_PERIOD, run);
+  for (std::size_t i = 0; i != FAN_OUT_WIDTH; ++i) {
+    auto sink = engine.createNode<Relay<0>>(fmt::format("sink{}", i), std::chrono::nanoseconds{}, run);
+    sink->connectInput(run, source, "fan_out");
+  }
+}
+
+void createFanIn(heph::conduit::NodeEngine& engine, Run& run) {
+  auto sink = engine.createNode<Relay<FAN_IN_WIDTH - 1>>("sink", std::chrono::nanoseconds{}, run);
+  for (std::size_t i = 0; i != FAN_IN_WIDTH; ++i) {
+    auto source = engine.createNode<Source>(fmt::format("source{}", i), SYNTHETIC_PERIOD, run);
+    if (i == 0) {
+      sink->connectInput(run, source, "fan_in");
+    } else {
+      sink->connectPolled(run, i - 1, source, "fan_in");
+    }
+  }
+}
+
+/// Topology and rates of the Mont Blanc reference system, see `examples/mont_blanc.cpp`. Inputs which
+/// are awaited there trigger the node here, all others are polled.
+void createMontBlanc(heph::conduit::NodeEngine& engine, Run& run) {
+  static constexpr auto NONE = std::chrono::nanoseconds{};
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  auto cordoba = engine.createNode<Source>("cordoba", 100 * MS, run);
+  auto freeport = engine.createNode<Source>("freeport", 50 * MS, run);
+  auto medellin = engine.createNode<Source>("medellin", 10 * MS, run);
+  auto portsmouth = engine.createNode<Source>("portsmouth", 200 * MS, run);
+  auto delhi = engine.createNode<Source>("delhi", 1000 * MS, run);
+  auto hebron = engine.createNode<Source>("hebron", 100 * MS, run);
+  auto kingston = engine.createNode<Source>("kingston", 100 * MS, run);
+
+  auto lyon = engine.createNode<Relay<0>>("lyon", NONE, run);
+  auto hamburg = engine.createNode<Relay<3>>("hamburg", NONE, run);
+  auto taipei = engine.createNode<Relay<0>>("taipei", NONE, run);
+  auto osaka = engine.createNode<Relay<2>>("osaka", NONE, run);
+  auto tripoli = engine.createNode<Relay<1>>("tripoli", NONE, run);
+  auto mandalay = engine.createNode<Sampler<6>>("mandalay", 100 * MS, run);
+  auto ponce = engine.createNode<Relay<8>>("ponce", NONE, run);
+  auto geneva = engine.createNode<Relay<3>>("geneva", NONE, run);
+  auto monaco = engine.createNode<Relay<0>>("monaco", NONE, run);
+  auto rotterdam = engine.createNode<Relay<0>>("rotterdam", NONE, run);
+  auto barcelona = engine.createNode<Relay<0>>("barcelona", NONE, run);
+  auto arequipa = engine.createNode<Relay<0>>("arequipa", NONE, run);
+  auto georgetown = engine.createNode<Sampler<2>>("georgetown", 50 * MS, run);
+
+  lyon->connectInput(run, cordoba, "amazon");
+
+  hamburg->connectInput(run, portsmouth, "danube");
+  hamburg->connectPolled(run, 0, lyon, "tigris");
+  hamburg->connectPolled(run, 1, freeport, "ganges");
+  hamburg->connectPolled(run, 2, medellin, "nile");
+
+  taipei->connectInput(run, delhi, "columbia");
+
+  osaka->connectInput(run, taipei, "colorado");
+  osaka->connectPolled(run, 0, hamburg, "parana");
+  osaka->connectPolled(run, 1, delhi, "columbia");
+
+  tripoli->connectInput(run, osaka, "godavari");
+  tripoli->connectPolled(run, 0, delhi, "columbia");
+
+  mandalay->connectPolled(run, 0, portsmouth, "danube");
+  mandalay->connectPolled(run, 1, hebron, "chenab");
+  mandalay->connectPolled(run, 2, osaka, "salween");
+  mandalay->connectPolled(run, 3, osaka, "godavari");
+  mandalay->connectPolled(run, 4, kingston, "yamuna");
+  mandalay->connectPolled(run, 5, tripoli, "loire");
+
+  ponce->connectInput(run, mandalay, "brazos");
+  ponce->connectPolled(run, 0, mandalay, "tagus");
+  ponce->connectPolled(run, 1, portsmouth, "danube");
+  ponce->connectPolled(run, 2, mandalay, "missouri");
+  ponce->connectPolled(run, 3, kingston, "yamuna");
+  ponce->connectPolled(run, 4, osaka, "godavari");
+  ponce->connectPolled(run, 5, tripoli, "loire");
+  ponce->connectPolled(run, 6, monaco, "ohio");
+  ponce->connectPolled(run, 7, georgetown, "volga");
+
+  geneva->connectInput(run, hamburg, "parana");
+  geneva->connectPolled(run, 0, portsmouth, "danube");
+  geneva->connectPolled(run, 1, mandalay, "tagus");
+  geneva->connectPolled(run, 2, ponce, "congo");
+
+  monaco->connectInput(run, ponce, "congo");
+  rotterdam->connectInput(run, ponce, "mekong");
+  barcelona->connectInput(run, ponce, "mekong");
+  arequipa->connectInput(run, geneva, "arkansas");
+
+  georgetown->connectPolled(run, 0, rotterdam, "murray");
+  georgetown->connectPolled(run, 1, barcelona, "lena");
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+
+using GraphFactoryT = void (*)(heph::conduit::NodeEngine&, Run&);
+struct Graph {
+  std::string_view name;
+  GraphFactoryT create;
+};
+
+constexpr std::array GRAPHS{ Graph{ .name = "chain", .create = &createChain },
+                             Graph{ .name = "fan_out", .create = &createFanOut },
+                             Graph{ .name = "fan_in", .create = &createFanIn },
+                             Graph{ .name = "mont_blanc", .create = &createMontBlanc } };
+
+auto toMicroseconds(std::chrono::nanoseconds duration) -> double {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+auto percentile(const std::vector<std::chrono::nanoseconds>& sorted, double fraction) -> double {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const auto index = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+  return toMicroseconds(sorted[index]);
+}
+
+auto runGraph(const Graph& graph, ClockMode clock_mode, const BenchmarkConfig& config,
+              DeadlineMissSink& deadline_misses) -> RunReport {
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  Run run{ config };
+  deadline_misses.reset();
+  heph::conduit::NodeEngine engine{
+    { .context_config = { .io_ring_config = {}, .timer_options = { .clock_mode = clock_mode } },
+      .prefix = "",
+      // The simulated clock is bound to a single context.
+      .number_of_contexts =
+          clock_mode == ClockMode::SIMULATED ? 1U : static_cast<std::uint32_t>(config.number_of_contexts),
+      .endpoints = {} }
+  };
+  graph.create(engine, run);
+  engine.createNode<Timeout>(config.duration);
+
+  const auto cpu_start = std::clock();
+  const auto wall_start = SteadyClockT::now();
+  engine.run();
+  const auto wall_time = std::chrono::duration<double>(SteadyClockT::now() - wall_start).count();
+  const auto process_cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  heph::telemetry::flushLogEntries();
+
+  RunReport report{ .graph = std::string{ graph.name },
+                    .clock_mode = clock_mode == ClockMode::SIMULATED ? "simulated" : "wallclock",
+                    .engine_time_s = std::chrono::duration<double>(engine.elapsed()).count(),
+                    .wall_time_s = wall_time,
+                    .process_cpu_s = process_cpu,
+                    .nodes = {},
+                    .edges = {} };
+  for (const auto& node : run.nodes()) {
+    report.nodes.push_back(
+        NodeReport{ .name = node.name,
+                    .executions = node.executions,
+                    .throughput_hz = static_cast<double>(node.executions) / wall_time,
+                    .execution_time_us = toMicroseconds(node.execution_time),
+                    .wall_time_share = std::chrono::duration<double>(node.execution_time).count() / wall_time,
+                    .cpu_time_us = toMicroseconds(node.cpu_time),
+                    .cpu_share = process_cpu > 0.0 ?
+                                     std::chrono::duration<double>(node.cpu_time).count() / process_cpu :
+                                     0.0,
+                    .deadline_misses = deadline_misses.misses(node.name) });
+  }
+  for (auto& edge : run.edges()) {
+    std::ranges::sort(edge.latencies);
+    report.edges.push_back(EdgeReport{ .name = edge.name,
+                                       .samples = edge.latencies.size(),
+                                       .p50_us = percentile(edge.latencies, 0.5),
+                                       .p90_us = percentile(edge.latencies, 0.9),
+                                       .p99_us = percentile(edge.latencies, 0.99),
+                                       .max_us = percentile(edge.latencies, 1.0) });
+  }
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  return report;
+}
+}  // namespace conduit_benchmark
+
+auto main(int argc, const char* argv[]) -> int {
+  try {
+    auto desc = heph::cli::ProgramDescription(
+        "Benchmark conduit graphs, reports latencies, throughput and deadline misses as JSON");
+    desc.defineOption<std::string>("graph", "Graph to run: chain, fan_out, fan_in, mont_blanc or all", "all")
+        .defineOption<std::string>("clock_mode", "Clock to run the graphs with: simulated, wallclock or all",
+                                   "all")
+        .defineOption<int>("duration_ms", "Duration of each run on the engine clock", 5000)
+        .defineOption<int>("work_us", "Time each node spends busy per execution", 0)
+        .defineOption<int>("contexts", "Number of contexts used for wall clock runs", 1)
+        .defineOption<std::string>("output", "File to write the JSON report to, stdout if empty", "");
+    const auto args = std::move(desc).parse(argc, argv);
+
+    const auto graph_name = args.getOption<std::string>("graph");
+    const auto clock_mode = args.getOption<std::string>("clock_mode");
+    const conduit_benchmark::BenchmarkConfig config{
+      .duration = std::chrono::milliseconds{ args.getOption<int>("duration_ms") },
+      .work = std::chrono::microseconds{ args.getOption<int>("work_us") },
+      .number_of_contexts = static_cast<std::size_t>(args.getOption<int>("contexts")),
+    };
+
+    auto& deadline_misses = heph::telemetry::makeAndRegisterLogSink<conduit_benchmark::DeadlineMissSink>();
+
+    std::vector<conduit_benchmark::RunReport> reports;
+    for (const auto& graph : conduit_benchmark::GRAPHS) {
+      if (graph_name != "all" && graph_name != graph.name) {
+        continue;
+      }
+      if (clock_mode == "all" || clock_mode == "simulated") {
+        reports.push_back(conduit_benchmark::runGraph(graph, conduit_benchmark::ClockMode::SIMULATED, config,
+                                                      deadline_misses));
+      }
+      if (clock_mode == "all" || clock_mode == "wallclock") {
+        reports.push_back(conduit_benchmark::runGraph(graph, conduit_benchmark::ClockMode::WALLCLOCK, config,
+                                                      deadline_misses));
+      }
+    }
+
+    const auto json = rfl::json::write(reports);
+    if (const auto output = args.getOption<std::string>("output"); !output.empty()) {
+      std::ofstream{ output } << json << '\n';
+    } else {
+      fmt::println("{}", json);
+    }
+  } catch (const std::exception& ex) {
+    fmt::println(stderr, "{}", ex.what());
+    return 1;
+  }
+
+  return 0;
+}
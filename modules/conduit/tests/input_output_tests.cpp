@@ -6,6 +6,8 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <random>
@@ -34,8 +36,9 @@
 #include "hephaestus/conduit/node_engine.h"
 #include "hephaestus/conduit/output.h"
 #include "hephaestus/conduit/queued_input.h"
-#include "hephaestus/telemetry/log/log.h"
-#include "hephaestus/telemetry/log/log_sink.h"
+#include "hephaestus/conduit/synchronized_input.h"
+#include "hephaestus/telemetry/metrics/metric_record.h"
+#include "hephaestus/telemetry/metrics/metric_sink.h"
 #include "hephaestus/types/dummy_type.h"
 #include "hephaestus/types_proto/dummy_type.h"
 #include "hephaestus/types_proto/numeric_value.h"
@@ -158,23 +161,63 @@ TEST(InputOutput, QueuedInputExplicitOutput) {
   EXPECT_EQ(*res, "Hello World!");
 }
 
+TEST(InputOutput, QueuedInputSharedOutput) {
+  NodeEngine engine{ {} };
+  exec::async_scope scope;
+  DummyOperation dummy;
+
+  QueuedInput<SharedValue<std::string>> shared_input1{ &dummy, "shared_input1" };
+  QueuedInput<SharedValue<std::string>> shared_input2{ &dummy, "shared_input2" };
+  QueuedInput<std::string> owning_input{ &dummy, "owning_input" };
+  Output<std::string> output{ &dummy, "output" };
+  shared_input1.connectTo(output);
+  owning_input.connectTo(output);
+  shared_input2.connectTo(output);
+  scope.spawn(output.setValue(engine, "Hello World!") | stdexec::then([&] { engine.requestStop(); }));
+  engine.run();
+  auto shared_res1 = shared_input1.getValue();
+  auto shared_res2 = shared_input2.getValue();
+  auto owning_res = owning_input.getValue();
+  EXPECT_TRUE(shared_res1.has_value());
+  EXPECT_TRUE(shared_res2.has_value());
+  EXPECT_TRUE(owning_res.has_value());
+  // Both borrowing inputs refer to the very same value
+  EXPECT_EQ(shared_res1->get(), shared_res2->get());
+  EXPECT_EQ(**shared_res1, "Hello World!");
+  EXPECT_EQ(*owning_res, "Hello World!");
+}
+
 namespace ht = heph::telemetry;
-class MockLogSink final : public ht::ILogSink {
+class MockMetricSink final : public ht::IMetricSink {
 public:
-  void send(const ht::LogEntry& s) override {
-    if (s.level == heph::WARN && s.message == detail::OutputConnections::INPUT_OVERFLOW_WARNING) {
-      ++num_messages;
-      fmt::println(stderr, "{}", fmt::join(s.fields, ", "));
+  explicit MockMetricSink(std::atomic<unsigned>* num_overflows) : num_overflows_(num_overflows) {
+  }
+
+  void send(const ht::Metric& metric) override {
+    if (metric.tag == detail::OutputConnections::INPUT_OVERFLOW_METRIC_TAG) {
+      ++(*num_overflows_);
+      fmt::println(stderr, "{}", metric.toString());
     }
   }
 
-  std::atomic<unsigned> num_messages{ 0 };
+private:
+  std::atomic<unsigned>* num_overflows_;
 };
 
+// Metric sinks can't be unregistered, a single sink counts the overflows of all tests.
+auto numOverflows() -> std::atomic<unsigned>& {
+  static std::atomic<unsigned> num_overflows{ 0 };
+  [[maybe_unused]] static const bool registered = [] {
+    heph::telemetry::registerMetricSink(std::make_unique<MockMetricSink>(&num_overflows));
+    return true;
+  }();
+  return num_overflows;
+}
+
 static constexpr auto TIMEOUT = std::chrono::milliseconds(10);
 
 TEST(InputOutput, QueuedInputOutputDelay) {
-  auto& mock_sink = heph::telemetry::makeAndRegisterLogSink<MockLogSink>();
+  const unsigned overflows_before = numOverflows().load();
 
   NodeEngine engine{ {} };
   exec::async_scope scope;
@@ -195,14 +238,12 @@ TEST(InputOutput, QueuedInputOutputDelay) {
   res = input.getValue();
   EXPECT_TRUE(res.has_value());
   EXPECT_EQ(*res, "Hello World Again!");
-  heph::telemetry::flushLogEntries();
-  EXPECT_GE(mock_sink.num_messages, 1);
-
-  EXPECT_TRUE(heph::telemetry::removeLogSink(mock_sink));
+  heph::telemetry::flushMetrics();
+  EXPECT_GT(numOverflows().load(), overflows_before);
 }
 
 TEST(InputOutput, QueuedInputOutputDelaySimulated) {
-  auto& mock_sink = heph::telemetry::makeAndRegisterLogSink<MockLogSink>();
+  const unsigned overflows_before = numOverflows().load();
 
   NodeEngine engine{
     { .context_config = { .io_ring_config = {},
@@ -229,10 +270,8 @@ TEST(InputOutput, QueuedInputOutputDelaySimulated) {
   res = input.getValue();
   EXPECT_TRUE(res.has_value());
   EXPECT_EQ(*res, "Hello World Again!");
-  heph::telemetry::flushLogEntries();
-  EXPECT_GE(mock_sink.num_messages.load(), 1);
-
-  EXPECT_TRUE(heph::telemetry::removeLogSink(mock_sink));
+  heph::telemetry::flushMetrics();
+  EXPECT_GT(numOverflows().load(), overflows_before);
 }
 
 TEST(InputOutput, handleStopped) {
@@ -412,6 +451,87 @@ TEST(InputOutput, AccumulatedTransformInputBase) {
                      }));
 }
 
+TEST(InputOutput, AccumulatedInputInPlace) {
+  static constexpr std::size_t DEPTH = 1000;
+  DummyOperation dummy;
+  AccumulatedInput<int, InputPolicy<DEPTH>> input{ &dummy, "input" };
+
+  // Wrap around the circular buffer before filling it up.
+  EXPECT_EQ(input.setValue(-1), InputState::OK);
+  EXPECT_TRUE(input.getValue().has_value());
+
+  std::vector<int> expected;
+  for (std::size_t i = 0; i != DEPTH; ++i) {
+    EXPECT_EQ(input.setValue(static_cast<int>(i)), InputState::OK);
+    expected.push_back(static_cast<int>(i));
+  }
+  EXPECT_EQ(input.setValue(0), InputState::OVERFLOW);
+
+  auto res_peek = input.peekValue();
+  auto res = input.getValue();
+  ASSERT_TRUE(res.has_value());
+  ASSERT_TRUE(res_peek.has_value());
+  EXPECT_EQ(*res, expected);
+  EXPECT_EQ(*res_peek, expected);
+  EXPECT_FALSE(input.getValue().has_value());
+  EXPECT_EQ(input.setValue(0), InputState::OK);
+}
+
+struct StampedValue {
+  std::chrono::nanoseconds timestamp;
+  int value;
+};
+
+auto stamped(std::int64_t timestamp_ms, int value) -> StampedValue {
+  return { .timestamp = std::chrono::milliseconds{ timestamp_ms }, .value = value };
+}
+
+TEST(InputOutput, SynchronizedInputExact) {
+  DummyOperation dummy;
+  SynchronizedInput<StampedValue, StampedValue> input{ &dummy, { "first", "second" } };
+
+  EXPECT_EQ(input.input<0>().setValue(stamped(1, 1)), InputState::OK);
+  EXPECT_FALSE(input.getValue().has_value());
+
+  // The first value of the second input is already too new for the first one.
+  EXPECT_EQ(input.input<1>().setValue(stamped(2, 2)), InputState::OK);
+  EXPECT_FALSE(input.getValue().has_value());
+  EXPECT_EQ(input.dropped(), 1U);
+
+  EXPECT_EQ(input.input<0>().setValue(stamped(2, 3)), InputState::OK);
+  auto res_peek = input.peekValue();
+  auto res = input.getValue();
+  ASSERT_TRUE(res_peek.has_value());
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(std::get<0>(*res).value, 3);
+  EXPECT_EQ(std::get<1>(*res).value, 2);
+  EXPECT_EQ(std::get<0>(*res_peek).value, 3);
+  EXPECT_FALSE(input.getValue().has_value());
+}
+
+TEST(InputOutput, SynchronizedInputTolerance) {
+  DummyOperation dummy;
+  SynchronizedInput<StampedValue, StampedValue, StampedValue> input{
+    &dummy, { "first", "second", "third" }, std::chrono::milliseconds{ 5 }
+  };
+
+  exec::async_scope scope;
+  std::optional<std::tuple<StampedValue, StampedValue, StampedValue>> res;
+  scope.spawn(input.get() | stdexec::then([&](auto value) { res = value; }));
+
+  EXPECT_EQ(input.input<0>().setValue(stamped(0, 0)), InputState::OK);
+  EXPECT_EQ(input.input<0>().setValue(stamped(10, 1)), InputState::OK);
+  EXPECT_EQ(input.input<1>().setValue(stamped(12, 2)), InputState::OK);
+  EXPECT_FALSE(res.has_value());
+  EXPECT_EQ(input.input<2>().setValue(stamped(8, 3)), InputState::OK);
+
+  ASSERT_TRUE(res.has_value());
+  EXPECT_EQ(std::get<0>(*res).value, 1);
+  EXPECT_EQ(std::get<1>(*res).value, 2);
+  EXPECT_EQ(std::get<2>(*res).value, 3);
+  EXPECT_EQ(input.dropped(), 1U);
+}
+
 struct AccumulatedNodeData {};
 
 struct AccumulatedNode : Node<AccumulatedNode, AccumulatedNodeData> {
@@ -492,6 +612,46 @@ TEST(InputOutput, ConcurrrentAccess) {
   producer.join();
 }
 
+struct OverwriteCompletionData {
+  std::optional<std::size_t> last;
+};
+
+struct OverwriteCompletionOperation : Node<OverwriteCompletionOperation, OverwriteCompletionData> {
+  QueuedInput<std::size_t, InputPolicy<1, RetrievalMethod::BLOCK, SetMethod::OVERWRITE>> input{ this,
+                                                                                                 "input" };
+
+  static auto trigger(OverwriteCompletionOperation& self) {
+    return self.input.get();
+  }
+
+  static auto execute(OverwriteCompletionOperation& self, std::size_t value) {
+    // Values may get overwritten, but never reordered.
+    if (self.data().last.has_value()) {
+      EXPECT_GT(value, *self.data().last);
+    }
+    self.data().last = value;
+    if (value == NUM_REPEATS - 1) {
+      self.engine().requestStop();
+    }
+  }
+};
+
+TEST(InputOutput, ConcurrentOverwrite) {
+  NodeEngine engine{ {} };
+  auto dummy = engine.createNode<OverwriteCompletionOperation>();
+
+  std::thread producer{ [&] {
+    for (std::size_t i = 0; i != NUM_REPEATS; ++i) {
+      // Overwriting inputs never reject values, even if the staged ones didn't get picked up yet.
+      EXPECT_EQ(dummy->input.setValue(i), InputState::OK);
+    }
+  } };
+  engine.run();
+  producer.join();
+
+  EXPECT_EQ(dummy->data().last, NUM_REPEATS - 1);
+}
+
 struct Generator : heph::conduit::Node<Generator> {
   static constexpr std::string_view NAME = "generator";
   static constexpr auto PERIOD = std::chrono::seconds(0);
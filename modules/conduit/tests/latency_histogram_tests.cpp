@@ -0,0 +1,58 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include <chrono>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "hephaestus/conduit/latency_histogram.h"
+
+namespace heph::conduit::tests {
+
+TEST(LatencyHistogramTests, empty) {
+  const LatencyHistogram histogram;
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.mean(), std::chrono::nanoseconds{ 0 });
+  EXPECT_EQ(histogram.percentile(0.5), std::chrono::nanoseconds{ 0 });
+}
+
+TEST(LatencyHistogramTests, percentiles) {
+  LatencyHistogram histogram;
+  static constexpr std::size_t NUM_SAMPLES = 100;
+  for (std::size_t i = 1; i <= NUM_SAMPLES; ++i) {
+    histogram.add(std::chrono::microseconds{ i });
+  }
+  EXPECT_EQ(histogram.count(), NUM_SAMPLES);
+  EXPECT_EQ(histogram.max(), std::chrono::microseconds{ 100 });
+  EXPECT_EQ(histogram.mean(), std::chrono::nanoseconds{ 50500 });
+  // The median of 50us falls into the bucket [32us, 64us).
+  EXPECT_EQ(histogram.percentile(0.5), std::chrono::microseconds{ 64 });
+  // Upper bounds never exceed the largest sample.
+  EXPECT_EQ(histogram.percentile(0.99), std::chrono::microseconds{ 100 });
+  EXPECT_EQ(histogram.percentile(1.0), std::chrono::microseconds{ 100 });
+
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0);
+}
+
+TEST(LatencyHistogramTests, outliers) {
+  LatencyHistogram histogram;
+  histogram.add(std::chrono::nanoseconds{ -1 });
+  histogram.add(std::chrono::hours{ 2 });
+  EXPECT_EQ(histogram.buckets().front(), 1);
+  EXPECT_EQ(histogram.buckets().back(), 1);
+}
+
+TEST(LatencyHistogramTests, merge) {
+  LatencyHistogram first;
+  LatencyHistogram second;
+  first.add(std::chrono::microseconds{ 10 });
+  second.add(std::chrono::microseconds{ 30 });
+  first.merge(second);
+  EXPECT_EQ(first.count(), 2);
+  EXPECT_EQ(first.mean(), std::chrono::microseconds{ 20 });
+  EXPECT_EQ(first.max(), std::chrono::microseconds{ 30 });
+}
+}  // namespace heph::conduit::tests
@@ -2,12 +2,16 @@
 // Copyright (C) 2023-2024 HEPHAESTUS Contributors
 //=================================================================================================
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdlib>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <exec/task.hpp>
 #include <fmt/base.h>
@@ -16,8 +20,12 @@
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/concurrency/io_ring/timer.h"
+#include "hephaestus/conduit/input.h"
 #include "hephaestus/conduit/node.h"
 #include "hephaestus/conduit/node_engine.h"
+#include "hephaestus/conduit/parallel_for.h"
+#include "hephaestus/conduit/queued_input.h"
+#include "hephaestus/conduit/trace_context.h"
 #include "hephaestus/telemetry/log/log.h"
 #include "hephaestus/telemetry/log/log_sink.h"
 
@@ -56,6 +64,21 @@ TEST(NodeTests, nodeBasic) {
   EXPECT_TRUE(dummy->data().executed);
   EXPECT_FALSE(ReceivingOperation::HAS_PERIOD);
   EXPECT_EQ(dummy->nodeName(), "/test/ReceivingOperation");
+  // Ids are exchanged between processes, they must not depend on the standard library.
+  EXPECT_EQ(dummy->nodeId(), 9630117697176177296ULL);  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+}
+
+TEST(NodeTests, duplicateNodeNames) {
+  NodeEngine engine{ {} };
+  auto first = engine.createNode<ReceivingOperation>();
+  auto second = engine.createNode<ReceivingOperation>();
+  engine.run();
+
+  EXPECT_EQ(first->nodeName(), second->nodeName());
+  EXPECT_NE(first->nodeId(), second->nodeId());
+  const auto statistics = engine.getNodeStatistics();
+  EXPECT_TRUE(statistics.contains(first->nodeId()));
+  EXPECT_TRUE(statistics.contains(second->nodeId()));
 }
 
 struct RepeatOperationData {
@@ -222,6 +245,12 @@ TEST(NodeTests, nodePeriodic) {
   EXPECT_GE(dummy->data().period_called, PeriodicOperation::RUNTIME / PeriodicOperation::PERIOD);
   EXPECT_GE(dummy->data().executed, PeriodicOperation::RUNTIME / PeriodicOperation::PERIOD);
   EXPECT_TRUE(PeriodicOperation::HAS_PERIOD);
+
+  const auto statistics = engine.getNodeStatistics().at(dummy->nodeId());
+  EXPECT_EQ(statistics.executions, dummy->data().executed);
+  EXPECT_EQ(statistics.execution_time.count(), dummy->data().executed);
+  EXPECT_EQ(statistics.period_jitter.count(), dummy->data().executed);
+  EXPECT_EQ(statistics.deadline_misses, 0);
 }
 
 TEST(NodeTests, nodePeriodicSimulated) {
@@ -277,6 +306,7 @@ TEST(NodeTests, nodePeriodicMissingDeadline) {
             PeriodicMissingDeadlineOperation::RUNTIME / (PeriodicMissingDeadlineOperation::PERIOD * 2));
   heph::telemetry::flushLogEntries();
   EXPECT_GE(mock_sink.num_messages.load(), 1);
+  EXPECT_GE(dummy->statistics().deadline_misses, 1);
   EXPECT_TRUE(PeriodicMissingDeadlineOperation::HAS_PERIOD);
 
   EXPECT_TRUE(heph::telemetry::removeLogSink(mock_sink));
@@ -327,4 +357,210 @@ TEST(NodeTests, coroutineTrigger) {
   EXPECT_TRUE(node->triggered);
   EXPECT_TRUE(node->executed);
 }
+
+struct MultiContextData {
+  std::size_t iteration{ 0 };
+  std::optional<std::thread::id> thread_id;
+};
+
+struct MultiContextProducer : Node<MultiContextProducer, MultiContextData> {
+  static constexpr std::size_t NUM_REPEATS = 100;
+
+  static auto trigger() {
+    return stdexec::just();
+  }
+
+  static auto execute(MultiContextProducer& self) -> std::size_t {
+    self.data().thread_id.emplace(std::this_thread::get_id());
+    return self.data().iteration++;
+  }
+};
+
+struct MultiContextConsumer : Node<MultiContextConsumer, MultiContextData> {
+  QueuedInput<std::size_t, InputPolicy<1>> input{ this, "input" };
+
+  static auto trigger(MultiContextConsumer& self) {
+    return self.input.get();
+  }
+
+  static void execute(MultiContextConsumer& self, std::size_t value) {
+    EXPECT_EQ(value, self.data().iteration);
+    self.data().thread_id.emplace(std::this_thread::get_id());
+    ++self.data().iteration;
+    if (self.data().iteration == MultiContextProducer::NUM_REPEATS) {
+      self.engine().requestStop();
+    }
+  }
+};
+
+TEST(NodeTests, multipleContexts) {
+  NodeEngine engine{ { .context_config = {}, .prefix = "", .number_of_contexts = 2, .endpoints = {} } };
+  EXPECT_EQ(engine.numberOfContexts(), 2);
+
+  auto producer = engine.createNodeOn<MultiContextProducer>(NodeEngine::MAIN_CONTEXT);
+  auto consumer = engine.createNodeOn<MultiContextConsumer>(1);
+  consumer->input.connectTo(producer);
+  engine.run();
+
+  EXPECT_EQ(consumer->data().iteration, MultiContextProducer::NUM_REPEATS);
+  ASSERT_TRUE(producer->data().thread_id.has_value());
+  ASSERT_TRUE(consumer->data().thread_id.has_value());
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  EXPECT_NE(*producer->data().thread_id, *consumer->data().thread_id);
+}
+
+TEST(NodeTests, balancedPlacement) {
+  NodeEngine engine{ { .context_config = {}, .prefix = "", .number_of_contexts = 2, .endpoints = {} } };
+  auto first = engine.createNode<MultiContextProducer>();
+  auto second = engine.createNode<MultiContextProducer>();
+  EXPECT_NE(first->scheduler(), second->scheduler());
+  engine.requestStop();
+  engine.run();
+}
+
+struct TracedSource : Node<TracedSource> {
+  static constexpr auto PERIOD = std::chrono::milliseconds{ 1 };
+
+  static auto execute() -> std::size_t {
+    return 0;
+  }
+};
+
+struct TracedRelay : Node<TracedRelay> {
+  QueuedInput<std::size_t> input{ this, "input" };
+
+  static auto trigger(TracedRelay& self) {
+    return self.input.get();
+  }
+
+  static auto execute(std::size_t value) -> std::size_t {
+    return value + 1;
+  }
+};
+
+struct TracedSinkData {
+  static constexpr std::size_t NUM_ITERATIONS = 10;
+
+  std::size_t iteration{ 0 };
+  TraceContext trace;
+};
+
+struct TracedSink : Node<TracedSink, TracedSinkData> {
+  QueuedInput<std::size_t> input{ this, "input" };
+
+  static auto trigger(TracedSink& self) {
+    return self.input.get();
+  }
+
+  static void execute(TracedSink& self, std::size_t /*value*/) {
+    self.data().trace = self.inputTrace();
+    if (++self.data().iteration == TracedSinkData::NUM_ITERATIONS) {
+      self.engine().requestStop();
+    }
+  }
+};
+
+TEST(NodeTests, tracing) {
+  NodeEngine engine{ { .context_config = { .io_ring_config = {},
+                                           .timer_options = { concurrency::io_ring::ClockMode::SIMULATED } },
+                       .prefix = "",
+                       .endpoints = {},
+                       .enable_tracing = true } };
+  auto source = engine.createNode<TracedSource>();
+  auto relay = engine.createNode<TracedRelay>();
+  auto sink = engine.createNode<TracedSink>();
+  relay->input.connectTo(source);
+  sink->input.connectTo(relay);
+  engine.run();
+
+  const auto& trace = sink->data().trace;
+  EXPECT_TRUE(trace.valid());
+  EXPECT_EQ(trace.origin_node, source->nodeId());
+  EXPECT_EQ(trace.hops, 1);
+
+  const auto latencies = engine.getPathLatencies();
+  const auto it = std::ranges::find_if(latencies, [&](const PathLatency& latency) {
+    return latency.origin == source->nodeName() && latency.node == sink->nodeName();
+  });
+  ASSERT_NE(it, latencies.end());
+  EXPECT_EQ(it->histogram.count(), TracedSinkData::NUM_ITERATIONS);
+
+  const auto dot_graph = engine.getDotGraph(true);
+  EXPECT_NE(dot_graph.find("executions: 10"), std::string::npos);
+  EXPECT_NE(dot_graph.find("[label=\"overflows: 0\"]"), std::string::npos);
+}
+
+TEST(NodeTests, fuseLinearChains) {
+  NodeEngine engine{ { .context_config = {}, .prefix = "", .endpoints = {}, .fuse_linear_chains = true } };
+  auto source = engine.createNode<MultiContextProducer>();
+  auto relay = engine.createNode<TracedRelay>();
+  auto sink = engine.createNode<TracedSink>();
+  auto consumer = engine.createNode<MultiContextConsumer>();
+  relay->input.connectTo(source);
+  consumer->input.connectTo(source);
+  sink->input.connectTo(relay);
+  engine.run();
+
+  // The source feeds two nodes, only the relay feeding the sink forms a linear chain.
+  EXPECT_FALSE(source->fused());
+  EXPECT_FALSE(relay->fused());
+  EXPECT_FALSE(consumer->fused());
+  EXPECT_TRUE(sink->fused());
+  EXPECT_EQ(sink->data().iteration, TracedSinkData::NUM_ITERATIONS);
+
+  const auto statistics = engine.getNodeStatistics();
+  EXPECT_EQ(statistics.at(sink->nodeId()).executions, TracedSinkData::NUM_ITERATIONS);
+}
+
+struct ParallelForData {
+  static constexpr std::size_t SIZE = 10000;
+
+  std::vector<std::size_t> values = std::vector<std::size_t>(SIZE, 0);
+  std::optional<std::thread::id> context_thread;
+  std::optional<std::thread::id> completion_thread;
+  std::atomic<std::size_t> pool_chunks{ 0 };
+};
+
+struct ParallelForOperation : Node<ParallelForOperation, ParallelForData> {
+  static auto trigger() {
+    return stdexec::just();
+  }
+
+  static auto execute(ParallelForOperation& self) {
+    self.data().context_thread.emplace(std::this_thread::get_id());
+    return parallelFor(self, ParallelForData::SIZE,
+                       [&self](std::size_t begin, std::size_t end) {
+                         if (std::this_thread::get_id() != self.data().context_thread) {
+                           ++self.data().pool_chunks;
+                         }
+                         for (std::size_t i = begin; i != end; ++i) {
+                           self.data().values[i] = i;
+                         }
+                       }) |
+           stdexec::then([&self] {
+             self.data().completion_thread.emplace(std::this_thread::get_id());
+             self.engine().requestStop();
+           });
+  }
+};
+
+TEST(NodeTests, parallelFor) {
+  NodeEngine engine{ { .context_config = {}, .prefix = "", .number_of_threads = 4, .endpoints = {} } };
+  auto node = engine.createNode<ParallelForOperation>();
+  engine.run();
+
+  for (std::size_t i = 0; i != ParallelForData::SIZE; ++i) {
+    EXPECT_EQ(node->data().values[i], i);
+  }
+  EXPECT_EQ(node->data().pool_chunks.load(), detail::parallelForChunks(ParallelForData::SIZE, 4, {}));
+  EXPECT_EQ(node->data().completion_thread, node->data().context_thread);
+}
+
+TEST(NodeTests, parallelForChunks) {
+  EXPECT_EQ(detail::parallelForChunks(0, 4, {}), 0);
+  EXPECT_EQ(detail::parallelForChunks(3, 4, {}), 3);
+  EXPECT_EQ(detail::parallelForChunks(1000, 4, {}), 16);
+  EXPECT_EQ(detail::parallelForChunks(1000, 4, { .min_chunk_size = 300, .chunks_per_thread = 4 }), 4);
+  EXPECT_EQ(detail::parallelForChunks(1000000, 1000, {}), PARALLEL_FOR_MAX_CHUNKS);
+}
 }  // namespace heph::conduit::tests
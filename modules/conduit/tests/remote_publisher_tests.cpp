@@ -2,26 +2,38 @@
 // Copyright (C) 2023-2024 HEPHAESTUS Contributors
 //=================================================================================================
 
+#include <array>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <vector>
 
+#include <exec/async_scope.hpp>
+#include <exec/task.hpp>
 #include <gtest/gtest.h>
 #include <stdexec/execution.hpp>
 
+#include "hephaestus/concurrency/context.h"
 #include "hephaestus/conduit/node.h"
 #include "hephaestus/conduit/node_engine.h"
 #include "hephaestus/conduit/queued_input.h"
 #include "hephaestus/conduit/remote_input_publisher.h"
+#include "hephaestus/conduit/remote_nodes.h"
 #include "hephaestus/conduit/remote_output_subscriber.h"
 #include "hephaestus/net/endpoint.h"
+#include "hephaestus/net/recv.h"
+#include "hephaestus/net/send.h"
+#include "hephaestus/net/socket.h"
+#include "hephaestus/serdes/serdes.h"
 #include "hephaestus/test_utils/heph_test.h"
 #include "hephaestus/types/dummy_type.h"
 #include "hephaestus/types_proto/dummy_type.h"
@@ -66,8 +78,40 @@ struct ReceivingOperation : Node<ReceivingOperation<T>, ReceivingOperationData>
   }
 };
 
+/// Produces messages well above the size of a single socket buffer.
+struct LargeGenerator : heph::conduit::Node<LargeGenerator> {
+  static constexpr std::string_view NAME = "large_generator";
+  static constexpr std::size_t VECTOR_SIZE = 1024ull * 1024;
+
+  static constexpr std::chrono::milliseconds PERIOD{ 10 };
+
+  static auto execute() {
+    types::DummyType value{};
+    value.dummy_vector.resize(VECTOR_SIZE, 1);
+    return value;
+  }
+};
+
+struct LargeReceivingOperation : Node<LargeReceivingOperation, ReceivingOperationData> {
+  QueuedInput<types::DummyType> input{ this, "input" };
+
+  static auto trigger(LargeReceivingOperation& operation) {
+    return operation.input.get();
+  }
+
+  static void execute(LargeReceivingOperation& operation, const types::DummyType& value) {
+    EXPECT_EQ(value.dummy_vector.size(), LargeGenerator::VECTOR_SIZE);
+    ++operation.data().executed;
+    if (operation.data().iterations == operation.data().executed) {
+      operation.engine().requestStop();
+    }
+  }
+};
+
 struct RemoteNodeTestParams {
   bool reliable;
+  std::uint16_t window;
+  bool datagram;
 };
 
 class RemoteNodeTests : public heph::test_utils::HephTest,
@@ -95,13 +139,15 @@ TEST_P(RemoteNodeTests, nodeBasic) {
   // Subscriber
   std::thread t2{ [&engine = engine2, remote_endpoints = engine1.endpoints()] {
     const bool reliable = GetParam().reliable;
+    const std::uint16_t window = GetParam().window;
+    const bool datagram = GetParam().datagram;
     static constexpr std::size_t NUM_ITERATIONS = 10;
     auto node = engine.createNode<ReceivingOperation<>>(NUM_ITERATIONS, 0);
 
     EXPECT_EQ(remote_endpoints.size(), 1);
     for (const auto& endpoint : remote_endpoints) {
       auto subscriber = engine.createNode<RemoteOutputSubscriber<heph::types::DummyType>>(
-          endpoint, std::string{ Generator::NAME }, reliable);
+          endpoint, std::string{ Generator::NAME }, reliable, window, datagram);
       node->input.connectTo(subscriber);
     }
     engine.run();
@@ -112,6 +158,92 @@ TEST_P(RemoteNodeTests, nodeBasic) {
   engine1.requestStop();
   t1.join();
 }
+
+TEST_P(RemoteNodeTests, multipleSubscribers) {
+  NodeEngineConfig config1;
+  config1.endpoints = { heph::net::Endpoint::createIpV4("127.0.0.1") };
+  NodeEngine engine1{ config1 };
+
+  // Publisher, serializing once for all subscribers
+  std::thread t1{ [&engine = engine1] {
+    [[maybe_unused]] auto node = engine.createNode<Generator>();
+
+    engine.run();
+  } };
+
+  // Subscribers
+  static constexpr std::size_t NUM_SUBSCRIBERS = 3;
+  std::vector<std::thread> subscribers;
+  subscribers.reserve(NUM_SUBSCRIBERS);
+  for (std::size_t i = 0; i != NUM_SUBSCRIBERS; ++i) {
+    subscribers.emplace_back([remote_endpoints = engine1.endpoints(), params = GetParam()] {
+      static constexpr std::size_t NUM_ITERATIONS = 10;
+      NodeEngine engine{ {} };
+      auto node = engine.createNode<ReceivingOperation<>>(NUM_ITERATIONS, 0);
+
+      auto subscriber = engine.createNode<RemoteOutputSubscriber<heph::types::DummyType>>(
+          remote_endpoints.front(), std::string{ Generator::NAME }, params.reliable, params.window,
+          params.datagram);
+      node->input.connectTo(subscriber);
+      engine.run();
+      EXPECT_EQ(node->data().executed, NUM_ITERATIONS);
+    });
+  }
+  for (auto& subscriber : subscribers) {
+    subscriber.join();
+  }
+  engine1.requestStop();
+  t1.join();
+}
+
+namespace {
+void exchangeLargeMessages(const heph::net::Endpoint& endpoint, const RemoteNodeTestParams& params) {
+  if (params.datagram) {
+    GTEST_SKIP() << "Datagrams are neither meant for megabytes per message nor available for IPC endpoints";
+  }
+  NodeEngineConfig config1;
+  config1.endpoints = { endpoint };
+  NodeEngine engine1{ config1 };
+
+  // Publisher
+  std::thread t1{ [&engine = engine1] {
+    [[maybe_unused]] auto node = engine.createNode<LargeGenerator>();
+
+    engine.run();
+  } };
+
+  // Subscriber
+  std::thread t2{ [remote_endpoints = engine1.endpoints(), params] {
+    const bool reliable = params.reliable;
+    const std::uint16_t window = params.window;
+    const bool datagram = params.datagram;
+    static constexpr std::size_t NUM_ITERATIONS = 10;
+    NodeEngine engine{ {} };
+    auto node = engine.createNode<LargeReceivingOperation>(NUM_ITERATIONS, 0);
+
+    EXPECT_EQ(remote_endpoints.size(), 1);
+    for (const auto& endpoint : remote_endpoints) {
+      auto subscriber = engine.createNode<RemoteOutputSubscriber<heph::types::DummyType>>(
+          endpoint, std::string{ LargeGenerator::NAME }, reliable, window, datagram);
+      node->input.connectTo(subscriber);
+    }
+    engine.run();
+    EXPECT_EQ(node->data().executed, NUM_ITERATIONS);
+  } };
+  t2.join();
+  engine1.requestStop();
+  t1.join();
+}
+}  // namespace
+
+TEST_P(RemoteNodeTests, largeMessages) {
+  exchangeLargeMessages(heph::net::Endpoint::createIpV4("127.0.0.1"), GetParam());
+}
+
+TEST_P(RemoteNodeTests, largeMessagesIpc) {
+  exchangeLargeMessages(heph::net::Endpoint::createIpc(), GetParam());
+}
+
 TEST_P(RemoteNodeTests, subscriberRestart) {
   NodeEngineConfig config1;
   config1.endpoints = { heph::net::Endpoint::createIpV4("127.0.0.1") };
@@ -127,6 +259,8 @@ TEST_P(RemoteNodeTests, subscriberRestart) {
   // Subscriber
   std::thread t2{ [remote_endpoints = engine1.endpoints()] {
     const bool reliable = GetParam().reliable;
+    const std::uint16_t window = GetParam().window;
+    const bool datagram = GetParam().datagram;
     static constexpr std::size_t NUM_ITERATIONS = 10;
     for (std::size_t i = 0; i != NUM_ITERATIONS; ++i) {
       NodeEngine engine{ {} };
@@ -135,7 +269,7 @@ TEST_P(RemoteNodeTests, subscriberRestart) {
       EXPECT_EQ(remote_endpoints.size(), 1);
       for (const auto& endpoint : remote_endpoints) {
         auto subscriber = engine.createNode<RemoteOutputSubscriber<heph::types::DummyType>>(
-            endpoint, std::string{ Generator::NAME }, reliable);
+            endpoint, std::string{ Generator::NAME }, reliable, window, datagram);
         node->input.connectTo(subscriber);
       }
       engine.run();
@@ -203,8 +337,10 @@ TEST_P(RemoteNodeTests, publisherRestart) {
     }
 
     const bool reliable = GetParam().reliable;
+    const std::uint16_t window = GetParam().window;
+    const bool datagram = GetParam().datagram;
     auto subscriber = subscriber_engine.createNode<RemoteOutputSubscriber<heph::types::DummyType>>(
-        remote_endpoint, std::string{ Generator::NAME }, reliable);
+        remote_endpoint, std::string{ Generator::NAME }, reliable, window, datagram);
     node->input.connectTo(subscriber);
     subscriber_engine.run();
     EXPECT_GT(node->data().executed, 0);
@@ -235,8 +371,10 @@ TEST_P(RemoteNodeTests, InputBasic) {
     std::vector<RemoteInputPublisher<types::DummyType>> remote_inputs;
     remote_inputs.reserve(remote_endpoints.size());
     const bool reliable = GetParam().reliable;
+    const std::uint16_t window = GetParam().window;
+    const bool datagram = GetParam().datagram;
     for (const auto& endpoint : remote_endpoints) {
-      remote_inputs.emplace_back(engine, endpoint, "ReceivingOperation/input", reliable);
+      remote_inputs.emplace_back(engine, endpoint, "ReceivingOperation/input", reliable, window, datagram);
       remote_inputs.back().connectTo(generator);
     }
     engine.run();
@@ -271,8 +409,10 @@ TEST_P(RemoteNodeTests, InputPublisherRestart) {
       std::vector<RemoteInputPublisher<types::DummyType>> remote_inputs;
       remote_inputs.reserve(remote_endpoints.size());
       const bool reliable = GetParam().reliable;
+      const std::uint16_t window = GetParam().window;
+      const bool datagram = GetParam().datagram;
       for (const auto& endpoint : remote_endpoints) {
-        remote_inputs.emplace_back(engine, endpoint, "ReceivingOperation/input", reliable);
+        remote_inputs.emplace_back(engine, endpoint, "ReceivingOperation/input", reliable, window, datagram);
         remote_inputs.back().connectTo(generator);
         auto node = engine.createNode<ReceivingOperation<bool>>(1, 0);
         node->input.connectTo(remote_inputs.back().onComplete());
@@ -313,8 +453,10 @@ TEST_P(RemoteNodeTests, InputSubscriberRestart) {
 
     [[maybe_unused]] auto generator = engine.createNode<Generator>();
     const bool reliable = GetParam().reliable;
+    const std::uint16_t window = GetParam().window;
+    const bool datagram = GetParam().datagram;
     RemoteInputPublisher<types::DummyType> remote_input(engine, remote_endpoint, "ReceivingOperation/input",
-                                                        reliable);
+                                                        reliable, window, datagram);
 
     remote_input.connectTo(generator);
 
@@ -357,6 +499,164 @@ TEST_P(RemoteNodeTests, InputSubscriberRestart) {
 }
 
 INSTANTIATE_TEST_SUITE_P(RemoteNodeTestCases, RemoteNodeTests,
-                         ::testing::Values(RemoteNodeTestParams{ true }, RemoteNodeTestParams{ false }));
+                         ::testing::Values(
+                             RemoteNodeTestParams{ .reliable = true, .window = 1, .datagram = false },
+                             RemoteNodeTestParams{ .reliable = true, .window = 4, .datagram = false },
+                             RemoteNodeTestParams{ .reliable = false, .window = 1, .datagram = false },
+                             RemoteNodeTestParams{ .reliable = false, .window = 1, .datagram = true }));
+
+struct RemoteProtocolTests : heph::test_utils::HephTest {};
+
+TEST_F(RemoteProtocolTests, oversizedFrameDropsConnection) {
+  NodeEngineConfig config;
+  config.endpoints = { heph::net::Endpoint::createIpV4("127.0.0.1") };
+  NodeEngine engine{ config };
+  auto node = engine.createNode<ReceivingOperation<>>(1, 0);
+  const auto endpoint = engine.endpoints().front();
+
+  std::thread clients{ [&endpoint] {
+    // Announces a frame above the maximum size, the connection gets closed without reading it.
+    {
+      exec::async_scope scope;
+      heph::concurrency::Context context{ {} };
+      auto socket = heph::net::Socket::createTcpIpV4(context);
+      bool closed = false;
+      // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+      auto send_oversized = [&]() -> exec::task<void> {
+        const std::string type_info = heph::serdes::getSerializedTypeInfo<types::DummyType>().toJson();
+        const std::string name = "ReceivingOperation/input";
+        RemoteNodeType type{};
+        EXPECT_EQ(co_await internal::connect(socket, endpoint, type_info, type, name), CONNECT_SUCCESS);
+        const internal::FrameSizeT header = internal::MAX_FRAME_SIZE + 1;
+        co_await heph::net::sendAll(socket, std::as_bytes(std::span{ &header, 1 }));
+        std::byte data{};
+        closed = co_await (heph::net::recv(socket, std::span{ &data, 1 }) |
+                           stdexec::then([](auto /*unused*/) { return false; }) |
+                           stdexec::upon_stopped([] { return true; }));
+        context.requestStop();
+      };
+      scope.spawn(send_oversized());
+      context.run();
+      EXPECT_TRUE(closed);
+    }
+
+    // The engine keeps serving other clients.
+    NodeEngine publisher{ {} };
+    [[maybe_unused]] auto generator = publisher.createNode<Generator>();
+    RemoteInputPublisher<types::DummyType> remote_input(publisher, endpoint, "ReceivingOperation/input");
+    remote_input.connectTo(generator);
+    auto completion = publisher.createNode<ReceivingOperation<bool>>(1, 0);
+    completion->input.connectTo(remote_input.onComplete());
+    publisher.run();
+  } };
+
+  EXPECT_NO_THROW(engine.run());
+  EXPECT_EQ(node->data().executed, 1);
+  clients.join();
+}
+
+TEST_F(RemoteProtocolTests, stalledReliableClientKeepsOtherClientsServed) {
+  NodeEngineConfig config;
+  config.endpoints = { heph::net::Endpoint::createIpV4("127.0.0.1") };
+  NodeEngine engine{ config };
+  [[maybe_unused]] auto generator = engine.createNode<Generator>();
+  const auto endpoint = engine.endpoints().front();
+  std::thread publisher{ [&engine] { engine.run(); } };
+
+  // Subscribes reliably, but neither reads nor acknowledges any value.
+  heph::concurrency::Context context{ {} };
+  auto socket = heph::net::Socket::createTcpIpV4(context);
+  {
+    exec::async_scope scope;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+    auto subscribe = [&]() -> exec::task<void> {
+      const std::string type_info = heph::serdes::getSerializedTypeInfo<types::DummyType>().toJson();
+      const std::string name{ Generator::NAME };
+      RemoteNodeType type{
+        .type = RemoteNodeType::OUTPUT, .reliable = true, .window = 1, .datagram = false
+      };
+      EXPECT_EQ(co_await internal::connect(socket, endpoint, type_info, type, name), CONNECT_SUCCESS);
+      context.requestStop();
+    };
+    scope.spawn(subscribe());
+    context.run();
+  }
+
+  static constexpr std::size_t NUM_ITERATIONS = 10;
+  NodeEngine subscriber_engine{ {} };
+  auto node = subscriber_engine.createNode<ReceivingOperation<>>(NUM_ITERATIONS, 0);
+  auto subscriber = subscriber_engine.createNode<RemoteOutputSubscriber<types::DummyType>>(
+      endpoint, std::string{ Generator::NAME });
+  node->input.connectTo(subscriber);
+  subscriber_engine.run();
+  EXPECT_EQ(node->data().executed, NUM_ITERATIONS);
+
+  engine.requestStop();
+  publisher.join();
+}
+
+struct DatagramTests : heph::test_utils::HephTest {};
+
+TEST_F(DatagramTests, multiFragmentMessage) {
+  exec::async_scope scope;
+  heph::concurrency::Context context{ {} };
+  auto receiver = heph::net::Socket::createUdpIpV4(context);
+  receiver.bind(heph::net::Endpoint::createIpV4("127.0.0.1"));
+  auto sender = heph::net::Socket::createUdpIpV4(context);
+  sender.connect(receiver.localEndpoint());
+
+  // Spans several datagrams, the last one only partially filled.
+  static constexpr std::size_t MESSAGE_SIZE = (5 * internal::MAX_FRAGMENT_SIZE) + 17;
+  std::vector<std::byte> sent(MESSAGE_SIZE);
+  for (std::size_t i = 0; i != sent.size(); ++i) {
+    sent[i] = static_cast<std::byte>(i % 251);  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  }
+  std::vector<std::byte> received;
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto read = [&]() -> exec::task<void> {
+    internal::DatagramReader reader;
+    co_await reader.read(receiver, received);
+    context.requestStop();
+  };
+  scope.spawn(read());
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto write = [&]() -> exec::task<void> {
+    // Fragments the writer never produces, they have to be dropped without touching the message.
+    struct InvalidFragment {
+      internal::DatagramHeader header;
+      std::size_t size;
+    };
+    static constexpr std::uint64_t TWO_FRAGMENTS = 2 * internal::MAX_FRAGMENT_SIZE;
+    static constexpr std::uint64_t OVERSIZED = internal::MAX_FRAME_SIZE + 1;
+    const std::array<std::byte, internal::MAX_FRAGMENT_SIZE> payload{};
+    const std::array<InvalidFragment, 4> invalid_fragments{ {
+        // Fragment count too small for the size.
+        { { .sequence = 1, .size = TWO_FRAGMENTS, .fragment = 0, .fragment_count = 1 }, payload.size() },
+        // Fragment beyond the end of the message.
+        { { .sequence = 1, .size = TWO_FRAGMENTS, .fragment = 2, .fragment_count = 2 }, payload.size() },
+        // Fragment shorter than its position in the message requires.
+        { { .sequence = 1, .size = TWO_FRAGMENTS, .fragment = 0, .fragment_count = 2 }, 1 },
+        // Message above the maximum size.
+        { { .sequence = 1,
+            .size = OVERSIZED,
+            .fragment = 0,
+            .fragment_count = static_cast<std::uint32_t>(internal::fragmentCount(OVERSIZED)) },
+          payload.size() },
+    } };
+    for (const auto& [header, size] : invalid_fragments) {
+      co_await heph::net::sendMsgAll(sender,
+                                     std::array{ std::as_bytes(std::span{ &header, 1 }),
+                                                 std::span<const std::byte>{ payload }.first(size) });
+    }
+    internal::DatagramWriter writer;
+    co_await writer.write(sender, sent);
+  };
+  scope.spawn(write());
+
+  context.run();
+  EXPECT_EQ(received, sent);
+}
 
 }  // namespace heph::conduit::tests
@@ -3,9 +3,13 @@
 //=================================================================================================
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <future>
 #include <memory>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -62,4 +66,153 @@ TEST(ZenohNodeTests, nodeBasic) {
   future.get();
 }
 
+namespace {
+/// Returns false if the node didn't receive `count` messages in time.
+template <typename SubscriberNodeT>
+auto waitForReceived(const SubscriberNodeT& node, std::uint64_t count) -> bool {
+  static constexpr std::chrono::seconds TIMEOUT{ 10 };
+  const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+  while (node.statistics().received != count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+  }
+  return true;
+}
+}  // namespace
+
+TEST(ZenohNodeTests, dropNewest) {
+  static constexpr std::size_t NUM_MESSAGES = 5;
+  NodeEngine engine{ {} };
+  auto zenoh_session = ipc::zenoh::createSession(ipc::zenoh::createLocalConfig());
+
+  [[maybe_unused]] auto publisher_node =
+      engine.createNode<ZenohPublisherNode<types::DummyType, "test_publisher">>(
+          zenoh_session, ipc::TopicConfig{ "test/drop_newest/output" });
+
+  // The engine isn't running, nothing leaves the handoff queue.
+  const ZenohSubscriberNode subscriber_node(
+      zenoh_session, ipc::TopicConfig{ "test/drop_newest/input" }, publisher_node->input,
+      { .overflow_policy = SubscriberOverflowPolicy::DROP_NEWEST, .queue_depth = 2 });
+
+  auto publisher =
+      ipc::zenoh::Publisher<types::DummyType>(zenoh_session, ipc::TopicConfig{ "test/drop_newest/input" });
+  for (std::size_t i = 0; i != NUM_MESSAGES; ++i) {
+    EXPECT_TRUE(publisher.publish(types::DummyType{}));
+  }
+
+  ASSERT_TRUE(waitForReceived(subscriber_node, NUM_MESSAGES));
+  EXPECT_EQ(subscriber_node.statistics().dropped, NUM_MESSAGES - 2);
+  EXPECT_EQ(subscriber_node.statistics().waited, 0);
+}
+
+TEST(ZenohNodeTests, dropOldest) {
+  static constexpr std::size_t NUM_MESSAGES = 5;
+  NodeEngine engine{ {} };
+  auto zenoh_session = ipc::zenoh::createSession(ipc::zenoh::createLocalConfig());
+
+  [[maybe_unused]] auto publisher_node =
+      engine.createNode<ZenohPublisherNode<types::DummyType, "test_publisher">>(
+          zenoh_session, ipc::TopicConfig{ "test/drop_oldest/output" });
+
+  const ZenohSubscriberNode subscriber_node(
+      zenoh_session, ipc::TopicConfig{ "test/drop_oldest/input" }, publisher_node->input,
+      { .overflow_policy = SubscriberOverflowPolicy::DROP_OLDEST, .queue_depth = 1 });
+
+  auto publisher =
+      ipc::zenoh::Publisher<types::DummyType>(zenoh_session, ipc::TopicConfig{ "test/drop_oldest/input" });
+  for (std::size_t i = 0; i != NUM_MESSAGES; ++i) {
+    types::DummyType msg;
+    msg.dummy_primitives_type.dummy_double = static_cast<double>(i);
+    EXPECT_TRUE(publisher.publish(msg));
+  }
+  ASSERT_TRUE(waitForReceived(subscriber_node, NUM_MESSAGES));
+  EXPECT_EQ(subscriber_node.statistics().dropped, NUM_MESSAGES - 1);
+
+  // Only the latest message is left to be handed over.
+  std::atomic_flag done = ATOMIC_FLAG_INIT;
+  auto subscriber = ipc::zenoh::Subscriber<types::DummyType>(
+      zenoh_session, ipc::TopicConfig{ "test/drop_oldest/output" },
+      [&done](const auto&, const std::shared_ptr<types::DummyType>& msg) {
+        EXPECT_EQ(msg->dummy_primitives_type.dummy_double, static_cast<double>(NUM_MESSAGES - 1));
+        done.test_and_set();
+        done.notify_all();
+      });
+
+  auto future = std::async(std::launch::async, [&engine]() { engine.run(); });
+  done.wait(false);
+  engine.requestStop();
+  future.get();
+}
+
+TEST(ZenohNodeTests, destroyWhileRunning) {
+  static constexpr std::size_t NUM_MESSAGES = 5;
+  NodeEngine engine{ {} };
+  auto zenoh_session = ipc::zenoh::createSession(ipc::zenoh::createLocalConfig());
+
+  [[maybe_unused]] auto publisher_node =
+      engine.createNode<ZenohPublisherNode<types::DummyType, "test_publisher">>(
+          zenoh_session, ipc::TopicConfig{ "test/destroy/output" });
+
+  auto future = std::async(std::launch::async, [&engine]() { engine.run(); });
+  {
+    const ZenohSubscriberNode subscriber_node(zenoh_session, ipc::TopicConfig{ "test/destroy/input" },
+                                              publisher_node->input);
+    auto publisher =
+        ipc::zenoh::Publisher<types::DummyType>(zenoh_session, ipc::TopicConfig{ "test/destroy/input" });
+    for (std::size_t i = 0; i != NUM_MESSAGES; ++i) {
+      EXPECT_TRUE(publisher.publish(types::DummyType{}));
+    }
+    EXPECT_TRUE(waitForReceived(subscriber_node, NUM_MESSAGES));
+  }
+  // The engine keeps running without the subscriber node.
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+  engine.requestStop();
+  future.get();
+}
+
+class ZenohBatchNodeTests : public ::testing::TestWithParam<ZenohBatchMode> {};
+
+TEST_P(ZenohBatchNodeTests, publishesEveryValue) {
+  static constexpr std::size_t NUM_MESSAGES = 20;
+  NodeEngine engine{ {} };
+  auto zenoh_session = ipc::zenoh::createSession(ipc::zenoh::createLocalConfig());
+
+  auto publisher_node = engine.createNode<ZenohBatchPublisherNode<types::DummyType, "test_publisher">>(
+      zenoh_session, ipc::TopicConfig{ "test/batch/output" }, GetParam());
+
+  const ZenohSubscriberNode subscriber_node(zenoh_session, ipc::TopicConfig{ "test/batch/input" },
+                                            publisher_node->input);
+
+  std::atomic<std::size_t> received{ 0 };
+  std::atomic_flag done = ATOMIC_FLAG_INIT;
+  auto subscriber = ipc::zenoh::Subscriber<types::DummyType>(
+      zenoh_session, ipc::TopicConfig{ "test/batch/output" },
+      [&](const auto&, const std::shared_ptr<types::DummyType>& msg) {
+        EXPECT_EQ(msg->dummy_primitives_type.dummy_double, static_cast<double>(received.load()));
+        if (++received == NUM_MESSAGES) {
+          done.test_and_set();
+          done.notify_all();
+        }
+      });
+
+  auto future = std::async(std::launch::async, [&engine]() { engine.run(); });
+
+  auto publisher =
+      ipc::zenoh::Publisher<types::DummyType>(zenoh_session, ipc::TopicConfig{ "test/batch/input" });
+  for (std::size_t i = 0; i != NUM_MESSAGES; ++i) {
+    types::DummyType msg;
+    msg.dummy_primitives_type.dummy_double = static_cast<double>(i);
+    EXPECT_TRUE(publisher.publish(msg));
+  }
+
+  done.wait(false);
+  engine.requestStop();
+  future.get();
+}
+
+INSTANTIATE_TEST_SUITE_P(ZenohBatchModes, ZenohBatchNodeTests,
+                         ::testing::Values(ZenohBatchMode::FRAMED, ZenohBatchMode::BURST));
+
 }  // namespace heph::conduit::tests
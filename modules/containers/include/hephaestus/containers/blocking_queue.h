@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <concepts>
 #include <condition_variable>
 #include <cstddef>
@@ -108,6 +109,35 @@ public:
     }
   }
 
+  /// Write the data to the queue. If no space is left in the queue, the function blocks until either
+  /// space is freed, `timeout` expired or stop is called.
+  /// \note This is safe to call from multiple threads.
+  /// \return true if the new data is added to the queue, false otherwise.
+  template <concepts::SimilarTo<T> U, typename Rep, typename Period>
+  [[nodiscard]] auto waitForAndPush(U&& obj, std::chrono::duration<Rep, Period> timeout) -> bool {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stop_) {
+        return false;
+      }
+
+      ++waiting_writers_;
+      const bool has_space =
+          writer_signal_.wait_for(lock, timeout, [this]() { return queue_.size() < max_size_ || stop_; });
+      --waiting_writers_;
+      if (!has_space || stop_) {
+        return false;
+      }
+
+      queue_.push_back(std::forward<U>(obj));
+    }
+
+    if (waiting_readers_ > 0) {
+      reader_signal_.notify_one();
+    }
+    return true;
+  }
+
   /// Attempt to enqueue the data if there is space in the queue. Support constructing a new element
   /// in-place.
   /// \note This is safe to call from multiple threads.
@@ -0,0 +1,90 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace heph::containers {
+
+/// Fixed size queue allowing multiple producers to push without locks, while a single consumer pops.
+/// Producers never block: pushing to a full queue fails and leaves the decision on what to do with
+/// the element to the caller. Based on the bounded queue by Dmitry Vyukov, each cell carries a
+/// sequence number signalling whether it is ready to be written or read.
+template <typename T, std::size_t Capacity>
+class BoundedMpscQueue {
+  static_assert(Capacity >= 2, "Sequence numbers of neighbouring cells would collide");
+
+public:
+  BoundedMpscQueue() {
+    for (std::size_t i = 0; i != Capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Attempt to enqueue the data if there is space in the queue.
+  /// \note This is safe to call from multiple threads.
+  /// \return true if the new data is added to the queue, false otherwise.
+  template <typename U>
+  [[nodiscard]] auto tryPush(U&& obj) -> bool {
+    auto position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell* cell{ nullptr };
+    while (true) {
+      cell = &cells_[position % Capacity];
+      const auto sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (diff == 0) {
+        if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value.emplace(std::forward<U>(obj));
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pop data from the queue if present.
+  /// \note Only a single thread is allowed to consume.
+  [[nodiscard]] auto tryPop() -> std::optional<T> {
+    Cell& cell = cells_[dequeue_position_ % Capacity];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+      return std::nullopt;
+    }
+    std::optional<T> res{ std::move(cell.value) };
+    cell.value.reset();
+    cell.sequence.store(dequeue_position_ + Capacity, std::memory_order_release);
+    ++dequeue_position_;
+    return res;
+  }
+
+  /// Returns true if there is nothing to pop.
+  /// \note Only meaningful on the consumer thread.
+  [[nodiscard]] auto empty() const -> bool {
+    return cells_[dequeue_position_ % Capacity].sequence.load(std::memory_order_acquire) !=
+           dequeue_position_ + 1;
+  }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    std::optional<T> value;
+  };
+
+  // Producers and the consumer operate on different cache lines.
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+  alignas(CACHE_LINE_SIZE) std::array<Cell, Capacity> cells_;
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_{ 0 };
+  alignas(CACHE_LINE_SIZE) std::size_t dequeue_position_{ 0 };
+};
+}  // namespace heph::containers
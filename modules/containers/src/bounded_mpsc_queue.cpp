@@ -0,0 +1,5 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include "hephaestus/containers/bounded_mpsc_queue.h"  // NOLINT(misc-include-cleaner)
@@ -2,6 +2,7 @@
 // Copyright (C) 2023-2024 HEPHAESTUS Contributors
 //=================================================================================================
 
+#include <chrono>
 #include <cstddef>
 #include <future>
 #include <limits>
@@ -92,6 +93,23 @@ TEST(BlockingQueue, WaitPush) {
   }
 }
 
+TEST(BlockingQueue, WaitForPush) {
+  constexpr int QUEUE_SIZE = 1;
+  BlockingQueue<int> block_queue(QUEUE_SIZE);
+  EXPECT_TRUE(block_queue.waitForAndPush(1, std::chrono::milliseconds{ 0 }));
+  EXPECT_FALSE(block_queue.waitForAndPush(2, std::chrono::milliseconds{ 1 }));
+  EXPECT_THAT(block_queue, SizeIs(1));
+
+  auto future =
+      std::async([&block_queue]() { return block_queue.waitForAndPush(3, std::chrono::hours{ 1 }); });
+  EXPECT_EQ(block_queue.waitAndPop(), 1);
+  EXPECT_TRUE(future.get());
+  EXPECT_EQ(block_queue.tryPop(), 3);
+
+  block_queue.stop();
+  EXPECT_FALSE(block_queue.waitForAndPush(4, std::chrono::hours{ 1 }));
+}
+
 TEST(BlockingQueue, TryEmplace) {
   constexpr int QUEUE_SIZE = 1;
   BlockingQueue<std::tuple<int, std::string, double>> block_queue(QUEUE_SIZE);
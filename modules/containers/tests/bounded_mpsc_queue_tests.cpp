@@ -0,0 +1,71 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hephaestus/containers/bounded_mpsc_queue.h"
+
+namespace heph::containers::tests {
+
+TEST(BoundedMpscQueue, PushPop) {
+  BoundedMpscQueue<std::string, 2> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.tryPop(), std::nullopt);
+
+  EXPECT_TRUE(queue.tryPush("a"));
+  EXPECT_TRUE(queue.tryPush(std::string{ "b" }));
+  EXPECT_FALSE(queue.tryPush("c"));
+  EXPECT_FALSE(queue.empty());
+
+  EXPECT_EQ(queue.tryPop(), "a");
+  EXPECT_TRUE(queue.tryPush("c"));
+  EXPECT_EQ(queue.tryPop(), "b");
+  EXPECT_EQ(queue.tryPop(), "c");
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.tryPop(), std::nullopt);
+}
+
+TEST(BoundedMpscQueue, MultipleProducers) {
+  static constexpr std::size_t NUM_PRODUCERS = 4;
+  static constexpr std::size_t NUM_ELEMENTS = 10000;
+  BoundedMpscQueue<std::size_t, 16> queue;
+
+  std::vector<std::thread> producers;
+  producers.reserve(NUM_PRODUCERS);
+  for (std::size_t producer = 0; producer != NUM_PRODUCERS; ++producer) {
+    producers.emplace_back([&queue, producer] {
+      for (std::size_t i = 0; i != NUM_ELEMENTS; ++i) {
+        while (!queue.tryPush((producer * NUM_ELEMENTS) + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Elements of a single producer arrive in order.
+  std::vector<std::size_t> next(NUM_PRODUCERS, 0);
+  for (std::size_t received = 0; received != NUM_PRODUCERS * NUM_ELEMENTS;) {
+    auto value = queue.tryPop();
+    if (!value.has_value()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto producer = *value / NUM_ELEMENTS;
+    EXPECT_EQ(*value % NUM_ELEMENTS, next[producer]);
+    ++next[producer];
+    ++received;
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+}  // namespace heph::containers::tests
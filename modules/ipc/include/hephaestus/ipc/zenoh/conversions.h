@@ -25,6 +25,9 @@ static constexpr auto TEXT_PLAIN_ENCODING = "text/plain";
 static constexpr auto PUBLISHER_ATTACHMENT_MESSAGE_COUNTER_KEY = "0";
 static constexpr auto PUBLISHER_ATTACHMENT_MESSAGE_SESSION_ID_KEY = "1";
 static constexpr auto PUBLISHER_ATTACHMENT_MESSAGE_TYPE_INFO = "2";
+/// Present for samples carrying a batch of messages, each of them prefixed by its size as `uint64_t`.
+/// Subscribers not knowing this key treat the whole batch as one message.
+static constexpr auto PUBLISHER_ATTACHMENT_MESSAGE_BATCH_SIZE_KEY = "3";
 
 [[nodiscard]] auto toByteVector(const ::zenoh::Bytes& bytes) -> std::vector<std::byte>;
 
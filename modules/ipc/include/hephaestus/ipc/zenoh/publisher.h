@@ -3,8 +3,13 @@
 //=================================================================================================
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "hephaestus/ipc/topic.h"
 #include "hephaestus/ipc/zenoh/raw_publisher.h"
@@ -32,12 +37,42 @@ public:
     return publisher_.publish(buffer);
   }
 
+  /// Publishes all of `data` with a single sample, see `RawPublisher::publishBatch`.
+  [[nodiscard]] auto publishBatch(std::span<const T> data) -> bool {
+    if (data.size() <= 1) {
+      return data.empty() || publish(data.front());
+    }
+    // Each value is serialized right behind its size, no copies are needed to frame the batch.
+    buffer_.clear();
+    for (const auto& value : data) {
+      const auto size_offset = buffer_.size();
+      buffer_.resize(size_offset + sizeof(std::uint64_t));
+      serdes::serializeAppend(value, buffer_);
+      const std::uint64_t size = buffer_.size() - size_offset - sizeof(std::uint64_t);
+      std::memcpy(buffer_.data() + size_offset, &size, sizeof(size));
+    }
+    return publisher_.publishFramedBatch(buffer_, data.size());
+  }
+
+  /// Publishes each of `data` with its own sample, one after the other.
+  [[nodiscard]] auto publishBurst(std::span<const T> data) -> bool {
+    bool success = true;
+    for (const auto& value : data) {
+      buffer_.clear();
+      serdes::serializeAppend(value, buffer_);
+      success = publisher_.publish(buffer_) && success;
+    }
+    return success;
+  }
+
   [[nodiscard]] auto sessionId() const -> std::string {
     return publisher_.sessionId();
   }
 
 private:
   RawPublisher publisher_;
+  // Reused by the batch operations, avoiding an allocation per message.
+  std::vector<std::byte> buffer_;
 };
 
 }  // namespace heph::ipc::zenoh
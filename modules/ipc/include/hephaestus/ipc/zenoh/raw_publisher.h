@@ -10,7 +10,8 @@
 #include <optional>
 #include <span>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <zenoh/api/ext/advanced_publisher.hxx>
 #include <zenoh/api/liveliness.hxx>
@@ -59,12 +60,24 @@ public:
 
   [[nodiscard]] auto publish(std::span<const std::byte> data) -> bool;
 
+  /// Publishes all `messages` with a single sample, amortizing the cost of a put over many small
+  /// messages. Subscribers receive them one by one, as if they were published individually.
+  /// \note Changes the wire format of the topic: subscribers built before batches got introduced ignore
+  /// `PUBLISHER_ATTACHMENT_MESSAGE_BATCH_SIZE_KEY` and receive the framed sample as a single message.
+  /// Only publish batches on topics whose subscribers have all been upgraded.
+  [[nodiscard]] auto publishBatch(std::span<const std::span<const std::byte>> messages) -> bool;
+
+  /// Publishes `count` messages framed the way `publishBatch` does: each of them is prefixed by its
+  /// size as `uint64_t`. Lets callers serialize straight into the framed buffer.
+  [[nodiscard]] auto publishFramedBatch(std::span<const std::byte> framed, std::size_t count) -> bool;
+
   [[nodiscard]] auto sessionId() const -> std::string {
     return toString(session_->zenoh_session.get_zid());
   }
 
 private:
-  [[nodiscard]] auto createPublisherOptions() -> ::zenoh::ext::AdvancedPublisher::PutOptions;
+  [[nodiscard]] auto createPublisherOptions(std::size_t batch_size = 1)
+      -> ::zenoh::ext::AdvancedPublisher::PutOptions;
   void createTypeInfoService();
   void initializeAttachment();
 
@@ -79,7 +92,9 @@ private:
   std::unique_ptr<Service<std::string, std::string>> type_service_;
 
   std::size_t pub_msg_count_ = 0;
-  std::unordered_map<std::string, std::string> attachment_;
+  // Entries of the attachment which are the same for every sample.
+  std::vector<std::pair<std::string, std::string>> attachment_;
+  std::vector<std::byte> batch_buffer_;
 
   MatchCallback match_cb_;
   std::unique_ptr<::zenoh::MatchingListener<void>> matching_listener_;
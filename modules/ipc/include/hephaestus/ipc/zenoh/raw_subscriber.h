@@ -58,10 +58,16 @@ public:
 
 private:
   void callback(const ::zenoh::Sample& sample);
+  /// Invokes the callback for each message carried by a sample.
+  void dispatch(MessageMetadata metadata, std::span<const std::byte> payload, std::size_t batch_size);
   void createTypeInfoService();
 
 private:
-  using Message = std::pair<MessageMetadata, std::vector<std::byte>>;
+  struct Message {
+    MessageMetadata metadata;
+    std::vector<std::byte> payload;
+    std::size_t batch_size{ 1 };
+  };
 
   SessionPtr session_;
   TopicConfig topic_config_;
@@ -5,6 +5,7 @@
 #include "hephaestus/ipc/zenoh/raw_publisher.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <span>
 #include <string>
@@ -85,11 +86,53 @@ auto RawPublisher::publish(std::span<const std::byte> data) -> bool {
   return result == Z_OK;
 }
 
-auto RawPublisher::createPublisherOptions() -> ::zenoh::ext::AdvancedPublisher::PutOptions {
+auto RawPublisher::publishBatch(std::span<const std::span<const std::byte>> messages) -> bool {
+  if (messages.empty()) {
+    return true;
+  }
+  if (messages.size() == 1) {
+    return publish(messages.front());
+  }
+
+  batch_buffer_.clear();
+  for (const auto& message : messages) {
+    const std::uint64_t size = message.size();
+    const auto size_bytes = std::as_bytes(std::span{ &size, 1 });
+    batch_buffer_.insert(batch_buffer_.end(), size_bytes.begin(), size_bytes.end());
+    batch_buffer_.insert(batch_buffer_.end(), message.begin(), message.end());
+  }
+  return publishFramedBatch(batch_buffer_, messages.size());
+}
+
+auto RawPublisher::publishFramedBatch(std::span<const std::byte> framed, std::size_t count) -> bool {
+  ::zenoh::ZResult result{};
+  auto bytes = toZenohBytes(framed);
+
+  auto options = createPublisherOptions(count);
+  publisher_->put(std::move(bytes), std::move(options), &result);
+  return result == Z_OK;
+}
+
+auto RawPublisher::createPublisherOptions(std::size_t batch_size)
+    -> ::zenoh::ext::AdvancedPublisher::PutOptions {
   auto put_options = ::zenoh::Publisher::PutOptions::create_default();
   put_options.encoding = ::zenoh::Encoding::Predefined::zenoh_bytes();
-  attachment_[PUBLISHER_ATTACHMENT_MESSAGE_COUNTER_KEY] = std::to_string(pub_msg_count_++);
-  put_options.attachment = ::zenoh::ext::serialize(attachment_);
+  // Written the way `std::unordered_map<std::string, std::string>` is serialized, subscribers read it as
+  // one. Only the counter and the batch size are encoded per sample.
+  ::zenoh::ext::Serializer serializer;
+  serializer.serialize_sequence_length(attachment_.size() + (batch_size > 1 ? 2 : 1));
+  for (const auto& entry : attachment_) {
+    serializer.serialize(entry);
+  }
+  // Messages of a batch are numbered consecutively, starting with the counter of the sample.
+  serializer.serialize(std::pair{ std::string{ PUBLISHER_ATTACHMENT_MESSAGE_COUNTER_KEY },
+                                  std::to_string(pub_msg_count_) });
+  pub_msg_count_ += batch_size;
+  if (batch_size > 1) {
+    serializer.serialize(
+        std::pair{ std::string{ PUBLISHER_ATTACHMENT_MESSAGE_BATCH_SIZE_KEY }, std::to_string(batch_size) });
+  }
+  put_options.attachment = std::move(serializer).finish();
 
   return { .put_options = std::move(put_options) };
 }
@@ -120,7 +163,8 @@ void RawPublisher::createTypeInfoService() {
 }
 
 void RawPublisher::initializeAttachment() {
-  attachment_[PUBLISHER_ATTACHMENT_MESSAGE_SESSION_ID_KEY] = toString(session_->zenoh_session.get_zid());
-  attachment_[PUBLISHER_ATTACHMENT_MESSAGE_TYPE_INFO] = type_info_.name;
+  attachment_.emplace_back(PUBLISHER_ATTACHMENT_MESSAGE_SESSION_ID_KEY,
+                           toString(session_->zenoh_session.get_zid()));
+  attachment_.emplace_back(PUBLISHER_ATTACHMENT_MESSAGE_TYPE_INFO, type_info_.name);
 }
 }  // namespace heph::ipc::zenoh
@@ -6,6 +6,8 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <memory>
 #include <span>
@@ -35,7 +37,8 @@
 
 namespace heph::ipc::zenoh {
 namespace {
-[[nodiscard]] auto getMetadata(const ::zenoh::Sample& sample, const std::string& topic) -> MessageMetadata {
+[[nodiscard]] auto getMetadata(const ::zenoh::Sample& sample, const std::string& topic,
+                               std::size_t* batch_size) -> MessageMetadata {
   std::string sender_id;
   std::string type_info;
   std::size_t sequence_id{};
@@ -48,6 +51,12 @@ namespace {
 
     sender_id = attachment_data[PUBLISHER_ATTACHMENT_MESSAGE_SESSION_ID_KEY];
     type_info = attachment_data[PUBLISHER_ATTACHMENT_MESSAGE_TYPE_INFO];
+
+    if (const auto it = attachment_data.find(PUBLISHER_ATTACHMENT_MESSAGE_BATCH_SIZE_KEY);
+        it != attachment_data.end()) {
+      res = absl::SimpleAtoi(it->second, batch_size);
+      heph::logIf(heph::ERROR, !res, "failed to read batch size from attachment", "service", topic);
+    }
   }
 
   auto timestamp = std::chrono::nanoseconds{ 0 };
@@ -83,9 +92,8 @@ RawSubscriber::RawSubscriber(SessionPtr session, TopicConfig topic_config, DataC
 
   if (dedicated_callback_thread_) {
     callback_messages_consumer_ = std::make_unique<concurrency::MessageQueueConsumer<Message>>(
-        [this](const Message& message) {
-          const auto& [metadata, buffer] = message;
-          callback_(metadata, std::span<const std::byte>(buffer.begin(), buffer.end()));
+        [this](Message&& message) {
+          dispatch(std::move(message.metadata), message.payload, message.batch_size);
         },
         DEFAULT_CACHE_RESERVES);
     callback_messages_consumer_->start();
@@ -132,15 +140,42 @@ RawSubscriber::~RawSubscriber() {
 }
 
 void RawSubscriber::callback(const ::zenoh::Sample& sample) {
-  const auto metadata = getMetadata(sample, topic_config_.name);
+  std::size_t batch_size = 1;
+  auto metadata = getMetadata(sample, topic_config_.name, &batch_size);
   auto payload = toByteVector(sample.get_payload());
 
   if (dedicated_callback_thread_) {
-    auto dropped_element = callback_messages_consumer_->queue().forceEmplace(metadata, std::move(payload));
+    auto dropped_element = callback_messages_consumer_->queue().forcePush(
+        Message{ .metadata = std::move(metadata), .payload = std::move(payload), .batch_size = batch_size });
     logIf(heph::ERROR, dropped_element.has_value(), "Dropped subscriber message due to full queue", "topic",
           topic_config_.name);
   } else {
-    callback_(metadata, { payload.data(), payload.size() });
+    dispatch(std::move(metadata), payload, batch_size);
+  }
+}
+
+void RawSubscriber::dispatch(MessageMetadata metadata, std::span<const std::byte> payload,
+                             std::size_t batch_size) {
+  if (batch_size <= 1) {
+    callback_(metadata, payload);
+    return;
+  }
+
+  for (std::size_t i = 0; i != batch_size; ++i) {
+    std::uint64_t size{ 0 };
+    if (payload.size() < sizeof(size)) {
+      heph::log(heph::ERROR, "truncated message batch", "topic", topic_config_.name, "message", i);
+      return;
+    }
+    std::memcpy(&size, payload.data(), sizeof(size));
+    payload = payload.subspan(sizeof(size));
+    if (payload.size() < size) {
+      heph::log(heph::ERROR, "truncated message batch", "topic", topic_config_.name, "message", i);
+      return;
+    }
+    callback_(metadata, payload.first(size));
+    payload = payload.subspan(size);
+    ++metadata.sequence_id;
   }
 }
 
@@ -1,10 +1,14 @@
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <fmt/format.h>
 #include <gmock/gmock.h>
@@ -59,6 +63,48 @@ void checkMessageExchange(std::mt19937_64& mt, bool subscriber_dedicated_callbac
   EXPECT_EQ(send_message, received_message);
 }
 
+void checkBatchExchange(std::mt19937_64& mt, bool subscriber_dedicated_callback_thread) {
+  static constexpr std::size_t BATCH_SIZE = 3;
+  auto session = createSession(createLocalConfig());
+  const auto topic =
+      ipc::TopicConfig(fmt::format("test_topic/{}", random::random<std::string>(mt, 10, false, true)));
+
+  Publisher<types::DummyType> publisher(session, topic);
+
+  std::mutex mutex;
+  std::vector<types::DummyType> received_messages;
+  std::vector<std::size_t> sequence_ids;
+  std::atomic_flag stop_flag = ATOMIC_FLAG_INIT;
+  SubscriberConfig config;
+  config.dedicated_callback_thread = subscriber_dedicated_callback_thread;
+  auto subscriber = createSubscriber<types::DummyType>(
+      session, topic,
+      [&](const MessageMetadata& metadata, const std::shared_ptr<types::DummyType>& message) {
+        const std::scoped_lock lock{ mutex };
+        received_messages.push_back(*message);
+        sequence_ids.push_back(metadata.sequence_id);
+        if (received_messages.size() == BATCH_SIZE + 1) {
+          stop_flag.test_and_set();
+          stop_flag.notify_all();
+        }
+      },
+      config);
+
+  std::vector<types::DummyType> send_messages;
+  for (std::size_t i = 0; i != BATCH_SIZE + 1; ++i) {
+    send_messages.push_back(types::DummyType::random(mt));
+  }
+  EXPECT_TRUE(publisher.publishBatch(std::span{ send_messages }.first(BATCH_SIZE)));
+  // Messages published on their own after a batch are not mistaken for one.
+  EXPECT_TRUE(publisher.publish(send_messages.back()));
+
+  stop_flag.wait(false);
+
+  const std::scoped_lock lock{ mutex };
+  EXPECT_EQ(received_messages, send_messages);
+  EXPECT_THAT(sequence_ids, ElementsAre(0, 1, 2, 3));
+}
+
 struct PublisherSubscriber : heph::test_utils::HephTest {};
 
 TEST_F(PublisherSubscriber, MessageExchange) {
@@ -66,6 +112,11 @@ TEST_F(PublisherSubscriber, MessageExchange) {
   checkMessageExchange(this->mt, true);
 }
 
+TEST_F(PublisherSubscriber, BatchExchange) {
+  checkBatchExchange(this->mt, false);
+  checkBatchExchange(this->mt, true);
+}
+
 TEST_F(PublisherSubscriber, MismatchType) {
   const Config config{};
   auto session = createSession(createLocalConfig());
@@ -0,0 +1,48 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include <sys/uio.h>
+
+namespace heph::net::detail {
+
+/// Fills `io_vectors` with the part of `buffers` following the first `skip` bytes, limited to `budget`
+/// bytes in total. Returns the number of used entries.
+template <typename T, std::size_t N>
+auto fillIoVectors(const std::array<std::span<T>, N>& buffers, std::size_t skip, std::size_t budget,
+                   std::array<::iovec, N>& io_vectors) -> std::size_t {
+  std::size_t count = 0;
+  for (auto buffer : buffers) {
+    if (budget == 0) {
+      break;
+    }
+    if (skip >= buffer.size()) {
+      skip -= buffer.size();
+      continue;
+    }
+    buffer = buffer.subspan(skip);
+    skip = 0;
+    const auto size = std::min(buffer.size(), budget);
+    budget -= size;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast) iovec is shared by reads and writes.
+    io_vectors[count++] = ::iovec{ .iov_base = const_cast<std::byte*>(buffer.data()), .iov_len = size };
+  }
+  return count;
+}
+
+template <typename T, std::size_t N>
+auto totalSize(const std::array<std::span<T>, N>& buffers) -> std::size_t {
+  std::size_t size = 0;
+  for (const auto& buffer : buffers) {
+    size += buffer.size();
+  }
+  return size;
+}
+}  // namespace heph::net::detail
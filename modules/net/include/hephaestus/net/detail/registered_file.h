@@ -0,0 +1,24 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <liburing.h>  // NOLINT(misc-include-cleaner)
+#include <liburing/io_uring.h>
+
+#include "hephaestus/net/socket.h"
+
+namespace heph::net::detail {
+
+/// Makes the prepared `sqe` refer to `socket` by its slot in the registered file table of the ring,
+/// sparing the kernel the lookup of the descriptor. Sockets without a slot keep their native handle.
+inline void useRegisteredFile(::io_uring_sqe* sqe, const Socket& socket) {
+  if (socket.registeredIndex() < 0) {
+    return;
+  }
+  sqe->fd = socket.registeredIndex();
+  sqe->flags |= IOSQE_FIXED_FILE;
+}
+
+}  // namespace heph::net::detail
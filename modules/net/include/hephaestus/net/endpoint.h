@@ -14,9 +14,9 @@
 namespace heph::net {
 
 #ifndef DISABLE_BLUETOOTH
-enum struct EndpointType : std::uint8_t { IPV4, IPV6, BT, INVALID };
+enum struct EndpointType : std::uint8_t { IPV4, IPV6, BT, IPC, INVALID };
 #else
-enum struct EndpointType : std::uint8_t { IPV4, IPV6, INVALID };
+enum struct EndpointType : std::uint8_t { IPV4, IPV6, IPC, INVALID };
 #endif
 
 class Endpoint {
@@ -38,13 +38,19 @@ public:
   static auto createBt(const std::string& mac = "", std::uint16_t psm = 0) -> Endpoint;
 #endif
 
+  /// Creates an endpoint for connections between processes on the same host, using a unix domain
+  /// socket in the abstract namespace. Binding to an empty name picks a unique one.
+  static auto createIpc(const std::string& name = "") -> Endpoint;
+
   [[nodiscard]] auto nativeHandle() const -> std::span<const std::byte>;
   [[nodiscard]] auto nativeHandle() -> std::span<std::byte>;
 
   [[nodiscard]] auto type() const {
     return type_;
   }
+  /// Returns the name for IPC endpoints.
   [[nodiscard]] auto address() const -> std::string;
+  /// Returns zero for IPC endpoints.
   [[nodiscard]] auto port() const -> std::uint16_t;
 
 private:
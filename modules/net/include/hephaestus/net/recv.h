@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <span>
 #include <system_error>
@@ -14,11 +15,15 @@
 
 #include <liburing.h>  // NOLINT(misc-include-cleaner)
 #include <liburing/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <stdexec/__detail/__execution_fwd.hpp>
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/net/detail/io_vector.h"
 #include "hephaestus/net/detail/operation_state.h"
+#include "hephaestus/net/detail/registered_file.h"
 #include "hephaestus/net/socket.h"
 
 namespace heph::net {
@@ -34,6 +39,18 @@ inline constexpr RecvT<false> recv{};
 // NOLINTNEXTLINE(readability-identifier-naming)
 inline constexpr RecvT<true> recvAll{};
 
+/// Receives into `buffers` in order with a single vectored `recvmsg`, scattering the received data
+/// across them. Completes with the number of bytes received.
+struct RecvMsgT {
+  template <std::size_t N>
+  auto operator()(const Socket& socket, std::array<std::span<std::byte>, N> buffers) const {
+    return concurrency::makeSenderExpression<RecvMsgT>(std::tuple{ &socket, buffers });
+  }
+};
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+inline constexpr RecvMsgT recvMsg{};
+
 namespace internal {
 template <bool RecvAll, typename Receiver>
 struct RecvOperation {
@@ -47,7 +64,14 @@ struct RecvOperation {
   void prepare(::io_uring_sqe* sqe) const {
     auto recv_size = std::min(socket->maximumRecvSize(), buffer.size() - transferred);
     auto to_transfer = buffer.subspan(transferred, recv_size);
-    ::io_uring_prep_recv(sqe, socket->nativeHandle(), to_transfer.data(), to_transfer.size(), MSG_NOSIGNAL);
+    // Reads into buffers registered with the ring spare the kernel to map the pages of the buffer.
+    if (const int index = socket->context().ring()->findFixedBuffer(to_transfer); index >= 0) {
+      ::io_uring_prep_read_fixed(sqe, socket->nativeHandle(), to_transfer.data(),
+                                 static_cast<unsigned>(to_transfer.size()), 0, index);
+    } else {
+      ::io_uring_prep_recv(sqe, socket->nativeHandle(), to_transfer.data(), to_transfer.size(), MSG_NOSIGNAL);
+    }
+    detail::useRegisteredFile(sqe, *socket);
   }
 
   auto handleCompletion(::io_uring_cqe* cqe) -> bool {
@@ -98,10 +122,74 @@ struct RecvSender : heph::concurrency::DefaultSenderExpressionImpl {
 
   static constexpr auto START = [](auto& operation, heph::concurrency::Ignore) { operation.submit(); };
 };
+
+template <std::size_t N, typename Receiver>
+struct RecvMsgOperation {
+  using StopTokenT = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+  const Socket* socket{ nullptr };
+  std::array<std::span<std::byte>, N> buffers;
+  Receiver receiver;
+  // Referenced by the submission until it completed.
+  mutable std::array<::iovec, N> io_vectors{};
+  mutable ::msghdr message{};
+
+  void prepare(::io_uring_sqe* sqe) const {
+    message = ::msghdr{};
+    message.msg_iov = io_vectors.data();
+    message.msg_iovlen = detail::fillIoVectors(buffers, 0, socket->maximumRecvSize(), io_vectors);
+    ::io_uring_prep_recvmsg(sqe, socket->nativeHandle(), &message, MSG_NOSIGNAL);
+    detail::useRegisteredFile(sqe, *socket);
+  }
+
+  auto handleCompletion(::io_uring_cqe* cqe) -> bool {
+    if (cqe->res < 0) {
+      stdexec::set_error(std::move(receiver), std::error_code(-cqe->res, std::system_category()));
+      return true;
+    }
+    if (cqe->res == 0) {
+      stdexec::set_stopped(std::move(receiver));
+      return true;
+    }
+    stdexec::set_value(std::move(receiver), static_cast<std::size_t>(cqe->res));
+    return true;
+  }
+
+  void handleStopped() {
+    stdexec::set_stopped(std::move(receiver));
+  }
+
+  auto getStopToken() {
+    return stdexec::get_stop_token(stdexec::get_env(receiver));
+  }
+};
+
+struct RecvMsgSender : heph::concurrency::DefaultSenderExpressionImpl {
+  static constexpr auto GET_COMPLETION_SIGNATURES = []<typename Sender>(
+                                                        Sender&&, heph::concurrency::Ignore = {}) noexcept {
+    return stdexec::completion_signatures<stdexec::set_value_t(std::size_t),
+                                          stdexec::set_error_t(std::error_code), stdexec::set_stopped_t()>{};
+  };
+
+  static constexpr auto GET_STATE = []<typename Sender, typename Receiver>(Sender&& sender,
+                                                                           Receiver&& receiver) noexcept {
+    auto [_, data] = std::forward<Sender>(sender);
+    auto [socket, buffers] = data;
+    auto* ring = socket->context().ring();
+    using RecvMsgOperationT = RecvMsgOperation<std::tuple_size_v<decltype(buffers)>, std::decay_t<Receiver>>;
+    using OperationStateT = detail::OperationState<RecvMsgOperationT>;
+    return OperationStateT{ ring, RecvMsgOperationT{ socket, buffers, std::forward<Receiver>(receiver) } };
+  };
+
+  static constexpr auto START = [](auto& operation, heph::concurrency::Ignore) { operation.submit(); };
+};
 }  // namespace internal
 }  // namespace heph::net
 
 namespace heph::concurrency {
 template <bool RecvAll>
 struct SenderExpressionImpl<heph::net::RecvT<RecvAll>> : heph::net::internal::RecvSender<RecvAll> {};
+
+template <>
+struct SenderExpressionImpl<heph::net::RecvMsgT> : heph::net::internal::RecvMsgSender {};
 }  // namespace heph::concurrency
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <span>
 #include <system_error>
@@ -14,11 +15,15 @@
 
 #include <liburing.h>  // NOLINT(misc-include-cleaner)
 #include <liburing/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <stdexec/__detail/__execution_fwd.hpp>
 #include <stdexec/execution.hpp>
 
 #include "hephaestus/concurrency/basic_sender.h"
+#include "hephaestus/net/detail/io_vector.h"
 #include "hephaestus/net/detail/operation_state.h"
+#include "hephaestus/net/detail/registered_file.h"
 #include "hephaestus/net/socket.h"
 
 namespace heph::net {
@@ -34,6 +39,18 @@ inline constexpr SendT<false> send{};
 // NOLINTNEXTLINE(readability-identifier-naming)
 inline constexpr SendT<true> sendAll{};
 
+/// Sends the concatenation of `buffers` entirely, each attempt being a single vectored `sendmsg`.
+/// Completes with the number of bytes sent.
+struct SendMsgAllT {
+  template <std::size_t N>
+  auto operator()(const Socket& socket, std::array<std::span<const std::byte>, N> buffers) const {
+    return concurrency::makeSenderExpression<SendMsgAllT>(std::tuple{ &socket, buffers });
+  }
+};
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+inline constexpr SendMsgAllT sendMsgAll{};
+
 namespace internal {
 template <bool SendAll, typename Receiver>
 struct SendOperation {
@@ -48,6 +65,7 @@ struct SendOperation {
     auto send_size = std::min(socket->maximumSendSize(), buffer.size() - transferred);
     auto to_transfer = buffer.subspan(transferred, send_size);
     ::io_uring_prep_send(sqe, socket->nativeHandle(), to_transfer.data(), to_transfer.size(), MSG_NOSIGNAL);
+    detail::useRegisteredFile(sqe, *socket);
   }
 
   auto handleCompletion(::io_uring_cqe* cqe) -> bool {
@@ -94,10 +112,76 @@ struct SendSender : heph::concurrency::DefaultSenderExpressionImpl {
 
   static constexpr auto START = [](auto& operation, heph::concurrency::Ignore) { operation.submit(); };
 };
+
+template <std::size_t N, typename Receiver>
+struct SendMsgOperation {
+  using StopTokenT = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+  const Socket* socket{ nullptr };
+  std::array<std::span<const std::byte>, N> buffers;
+  Receiver receiver;
+  std::size_t transferred{ 0 };
+  // Referenced by the submission until it completed.
+  mutable std::array<::iovec, N> io_vectors{};
+  mutable ::msghdr message{};
+
+  void prepare(::io_uring_sqe* sqe) const {
+    message = ::msghdr{};
+    message.msg_iov = io_vectors.data();
+    message.msg_iovlen = detail::fillIoVectors(buffers, transferred, socket->maximumSendSize(), io_vectors);
+    ::io_uring_prep_sendmsg(sqe, socket->nativeHandle(), &message, MSG_NOSIGNAL);
+    detail::useRegisteredFile(sqe, *socket);
+  }
+
+  auto handleCompletion(::io_uring_cqe* cqe) -> bool {
+    if (cqe->res < 0) {
+      stdexec::set_error(std::move(receiver), std::error_code(-cqe->res, std::system_category()));
+      return true;
+    }
+    transferred += static_cast<std::size_t>(cqe->res);
+    if (transferred != detail::totalSize(buffers)) {
+      return false;
+    }
+    stdexec::set_value(std::move(receiver), transferred);
+    return true;
+  }
+
+  void handleStopped() {
+    stdexec::set_stopped(std::move(receiver));
+  }
+
+  auto getStopToken() {
+    return stdexec::get_stop_token(stdexec::get_env(receiver));
+  }
+};
+
+struct SendMsgSender : heph::concurrency::DefaultSenderExpressionImpl {
+  static constexpr auto GET_COMPLETION_SIGNATURES = []<typename Sender>(
+                                                        Sender&&, heph::concurrency::Ignore = {}) noexcept {
+    return stdexec::completion_signatures<stdexec::set_value_t(std::size_t),
+                                          stdexec::set_error_t(std::error_code), stdexec::set_stopped_t()>{};
+  };
+
+  static constexpr auto GET_STATE = []<typename Sender, typename Receiver>(Sender&& sender,
+                                                                           Receiver&& receiver) noexcept {
+    auto [_, data] = std::forward<Sender>(sender);
+    auto [socket, buffers] = data;
+    auto* ring = socket->context().ring();
+    using SendMsgOperationT = SendMsgOperation<std::tuple_size_v<decltype(buffers)>, std::decay_t<Receiver>>;
+    using OperationStateT = detail::OperationState<SendMsgOperationT>;
+    return OperationStateT{ ring,
+                            SendMsgOperationT{ socket, buffers, std::forward<Receiver>(receiver), 0 } };
+  };
+
+  static constexpr auto START = [](auto& operation, heph::concurrency::Ignore) { operation.submit(); };
+};
 }  // namespace internal
 }  // namespace heph::net
 
 namespace heph::concurrency {
 template <bool sendAll>
 struct SenderExpressionImpl<heph::net::SendT<sendAll>> : heph::net::internal::SendSender<sendAll> {};
+
+template <>
+struct SenderExpressionImpl<heph::net::SendMsgAllT> : heph::net::internal::SendMsgSender {};
 }  // namespace heph::concurrency
@@ -0,0 +1,79 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace heph::net {
+
+/// Single producer, single consumer ring of messages in POSIX shared memory, used to exchange
+/// payloads between processes on the same host without passing them through the kernel. The ring
+/// only stores the data: the producer announces each message by its position and size through
+/// another channel, e.g. a unix domain socket, and the consumer releases messages in the same order.
+/// Messages are stored contiguously, a message not fitting before the end of the ring starts over at
+/// its beginning.
+class SharedMemoryRing {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 16ull * 1024 * 1024;
+
+  /// Creates a new ring of `capacity` bytes, to be written by the calling process.
+  static auto create(std::size_t capacity = DEFAULT_CAPACITY) -> SharedMemoryRing;
+  /// Maps the ring created under `name` for reading. The name gets removed once attached. Throws
+  /// `std::system_error` if there is no valid ring of that name.
+  static auto attach(const std::string& name) -> SharedMemoryRing;
+
+  ~SharedMemoryRing() noexcept;
+
+  SharedMemoryRing(const SharedMemoryRing&) = delete;
+  auto operator=(const SharedMemoryRing&) -> SharedMemoryRing& = delete;
+  SharedMemoryRing(SharedMemoryRing&& other) noexcept;
+  auto operator=(SharedMemoryRing&& other) noexcept -> SharedMemoryRing&;
+
+  [[nodiscard]] auto name() const -> const std::string& {
+    return name_;
+  }
+
+  [[nodiscard]] auto capacity() const -> std::size_t {
+    return capacity_;
+  }
+
+  /// Copies `message` into the ring and returns its position, or `std::nullopt` if the consumer
+  /// didn't release enough space yet.
+  [[nodiscard]] auto tryWrite(std::span<const std::byte> message) -> std::optional<std::uint64_t> {
+    return tryWrite(std::span{ &message, 1 });
+  }
+
+  /// Copies the concatenation of `parts` into the ring as one message, see `tryWrite`.
+  [[nodiscard]] auto tryWrite(std::span<const std::span<const std::byte>> parts)
+      -> std::optional<std::uint64_t>;
+
+  /// Returns the message written at `position`. It stays valid until released. Throws
+  /// `std::system_error` if the message is not within the written part of the ring.
+  [[nodiscard]] auto read(std::uint64_t position, std::size_t size) const -> std::span<const std::byte>;
+
+  /// Hands the space of the message at `position` back to the producer.
+  void release(std::uint64_t position, std::size_t size);
+
+private:
+  struct Header;
+
+  SharedMemoryRing(std::string name, void* mapping, std::size_t capacity, bool owner) noexcept;
+
+  [[nodiscard]] auto header() const -> Header*;
+  [[nodiscard]] auto data() const -> std::byte*;
+  void unmap() noexcept;
+
+private:
+  std::string name_;
+  void* mapping_{ nullptr };
+  std::size_t capacity_{ 0 };
+  std::uint64_t head_{ 0 };
+  bool owner_{ false };
+};
+}  // namespace heph::net
@@ -18,9 +18,9 @@ struct AcceptOperation;
 }
 
 #ifndef DISABLE_BLUETOOTH
-enum struct SocketType : std::uint8_t { TCP, UDP, L2CAP, INVALID };
+enum struct SocketType : std::uint8_t { TCP, UDP, L2CAP, UNIX, INVALID };
 #else
-enum struct SocketType : std::uint8_t { TCP, UDP, INVALID };
+enum struct SocketType : std::uint8_t { TCP, UDP, UNIX, INVALID };
 #endif
 
 class Socket {
@@ -40,6 +40,8 @@ public:
 #ifndef DISABLE_BLUETOOTH
   static auto createL2cap(concurrency::Context& context) -> Socket;
 #endif
+  /// Stream socket for connections between processes on the same host, see `Endpoint::createIpc`.
+  static auto createUnix(concurrency::Context& context) -> Socket;
 
   [[nodiscard]] auto type() const {
     return type_;
@@ -59,6 +61,12 @@ public:
     return fd_;
   }
 
+  /// Index of the socket in the registered file table of the ring of its context, -1 if the table is
+  /// full or not configured, see `IoRingConfig::registered_files`.
+  [[nodiscard]] auto registeredIndex() const -> int {
+    return registered_index_;
+  }
+
   [[nodiscard]] auto context() const -> concurrency::Context& {
     return *context_;
   }
@@ -86,6 +94,7 @@ private:
   std::size_t maximum_recv_size_{ std::numeric_limits<std::size_t>::max() };
   std::size_t maximum_send_size_{ std::numeric_limits<std::size_t>::max() };
   int fd_{ -1 };
+  int registered_index_{ -1 };
   SocketType type_{ SocketType::INVALID };
 };
 }  // namespace heph::net
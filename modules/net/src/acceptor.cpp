@@ -26,6 +26,9 @@ auto Acceptor::createL2cap(concurrency::Context& context) -> Acceptor {
   return Acceptor{ Socket::createL2cap(context) };
 }
 #endif
+auto Acceptor::createUnix(concurrency::Context& context) -> Acceptor {
+  return Acceptor{ Socket::createUnix(context) };
+}
 
 void Acceptor::listen(int backlog) const {
   const int res = ::listen(socket_.nativeHandle(), backlog);
@@ -23,6 +23,7 @@
 #include <fmt/format.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 
 #include "hephaestus/error_handling/panic.h"
 
@@ -84,6 +85,22 @@ auto Endpoint::createBt(const std::string& mac, std::uint16_t psm) -> Endpoint {
 }
 #endif
 
+auto Endpoint::createIpc(const std::string& name) -> Endpoint {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  // The leading null character of the path selects the abstract namespace.
+  if (name.size() >= sizeof(addr.sun_path)) {
+    panic("IPC name {} exceeds {} characters", name, sizeof(addr.sun_path) - 1);
+  }
+  std::memcpy(&addr.sun_path[1], name.data(), name.size());
+  // Binding to an address consisting of the family only lets the kernel assign a unique name.
+  const std::size_t size =
+      name.empty() ? sizeof(sa_family_t) : offsetof(sockaddr_un, sun_path) + 1 + name.size();
+  std::vector<std::byte> address(size);
+  std::memcpy(address.data(), &addr, size);
+  return Endpoint{ EndpointType::IPC, std::move(address) };
+}
+
 namespace {
 auto getPortIpV4(const std::vector<std::byte>& address) -> std::uint16_t {
   sockaddr_in addr{};
@@ -114,6 +131,8 @@ auto Endpoint::port() const -> std::uint16_t {
     case heph::net::EndpointType::BT:
       return getPortBt(address_);
 #endif
+    case heph::net::EndpointType::IPC:
+      return 0;
     default:
       heph::panic("Unknown family");
   }
@@ -159,6 +178,14 @@ auto getAddressBt(const std::vector<std::byte>& address) -> std::string {
   return std::string{ buffer.data() };
 }
 #endif
+auto getAddressIpc(const std::vector<std::byte>& address) -> std::string {
+  static constexpr std::size_t NAME_OFFSET = offsetof(sockaddr_un, sun_path) + 1;
+  if (address.size() <= NAME_OFFSET) {
+    return {};
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return { reinterpret_cast<const char*>(address.data()) + NAME_OFFSET, address.size() - NAME_OFFSET };
+}
 }  // namespace
 
 auto Endpoint::address() const -> std::string {
@@ -171,6 +198,8 @@ auto Endpoint::address() const -> std::string {
     case heph::net::EndpointType::BT:
       return getAddressBt(address_);
 #endif
+    case heph::net::EndpointType::IPC:
+      return getAddressIpc(address_);
     default:
       heph::panic("Unknown family");
   }
@@ -186,6 +215,9 @@ auto Endpoint::nativeHandle() -> std::span<std::byte> {
 }
 
 auto format_as(const Endpoint& endpoint) -> std::string {  // NOLINT(readability-identifier-naming)
+  if (endpoint.type() == EndpointType::IPC) {
+    return fmt::format("ipc:{}", endpoint.address());
+  }
   return fmt::format("{}:{}", endpoint.address(), endpoint.port());
 }
 }  // namespace heph::net
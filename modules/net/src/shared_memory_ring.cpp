@@ -0,0 +1,191 @@
+//=================================================================================================
+// Copyright (C) 2023-2025 HEPHAESTUS Contributors
+//=================================================================================================
+
+#include "hephaestus/net/shared_memory_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hephaestus/error_handling/panic.h"
+
+namespace heph::net {
+
+// Producer and consumer positions are kept on separate cache lines, positions only ever grow.
+struct SharedMemoryRing::Header {
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head{ 0 };
+  alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail{ 0 };
+};
+
+namespace {
+auto mapFile(int fd, std::size_t size) -> void* {
+  void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::system_category(), "mmap");
+  }
+  ::close(fd);
+  return mapping;
+}
+}  // namespace
+
+auto SharedMemoryRing::create(std::size_t capacity) -> SharedMemoryRing {
+  if (capacity == 0) {
+    panic("Shared memory ring needs a capacity");
+  }
+
+  static std::atomic<std::uint64_t> counter{ 0 };
+  std::string name;
+  int fd = -1;
+  while (fd == -1) {
+    name = fmt::format("/heph_net_{}_{}", ::getpid(), counter++);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1 && errno != EEXIST) {
+      panic("shm_open {}: {}", name, std::error_code(errno, std::system_category()).message());
+    }
+  }
+
+  const auto size = sizeof(Header) + capacity;
+  if (::ftruncate(fd, static_cast<off_t>(size)) == -1) {
+    const std::error_code error(errno, std::system_category());
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    panic("ftruncate {}: {}", name, error.message());
+  }
+
+  void* mapping = mapFile(fd, size);
+  new (mapping) Header{};
+  return SharedMemoryRing{ std::move(name), mapping, capacity, true };
+}
+
+auto SharedMemoryRing::attach(const std::string& name) -> SharedMemoryRing {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  if (fd == -1) {
+    throw std::system_error(errno, std::system_category(), fmt::format("shm_open {}", name));
+  }
+  // Both sides keep their mapping, nobody else needs to find the ring.
+  ::shm_unlink(name.c_str());
+
+  struct stat status{};
+  if (::fstat(fd, &status) == -1 || static_cast<std::size_t>(status.st_size) <= sizeof(Header)) {
+    ::close(fd);
+    throw std::system_error(EINVAL, std::system_category(),
+                            fmt::format("Invalid shared memory ring {}", name));
+  }
+
+  const auto size = static_cast<std::size_t>(status.st_size);
+  return SharedMemoryRing{ name, mapFile(fd, size), size - sizeof(Header), false };
+}
+
+SharedMemoryRing::SharedMemoryRing(std::string name, void* mapping, std::size_t capacity, bool owner) noexcept
+  : name_(std::move(name)), mapping_(mapping), capacity_(capacity), owner_(owner) {
+}
+
+SharedMemoryRing::~SharedMemoryRing() noexcept {
+  unmap();
+}
+
+SharedMemoryRing::SharedMemoryRing(SharedMemoryRing&& other) noexcept
+  : name_(std::move(other.name_))
+  , mapping_(std::exchange(other.mapping_, nullptr))
+  , capacity_(other.capacity_)
+  , head_(other.head_)
+  , owner_(other.owner_) {
+}
+
+auto SharedMemoryRing::operator=(SharedMemoryRing&& other) noexcept -> SharedMemoryRing& {
+  unmap();
+  name_ = std::move(other.name_);
+  mapping_ = std::exchange(other.mapping_, nullptr);
+  capacity_ = other.capacity_;
+  head_ = other.head_;
+  owner_ = other.owner_;
+  return *this;
+}
+
+void SharedMemoryRing::unmap() noexcept {
+  if (mapping_ == nullptr) {
+    return;
+  }
+  ::munmap(mapping_, sizeof(Header) + capacity_);
+  mapping_ = nullptr;
+  // The consumer removes the name once attached, this only cleans up rings nobody attached to.
+  if (owner_) {
+    ::shm_unlink(name_.c_str());
+  }
+}
+
+auto SharedMemoryRing::tryWrite(std::span<const std::span<const std::byte>> parts)
+    -> std::optional<std::uint64_t> {
+  std::size_t size = 0;
+  for (const auto& part : parts) {
+    size += part.size();
+  }
+  if (size > capacity_) {
+    return std::nullopt;
+  }
+
+  auto position = head_;
+  const auto offset = position % capacity_;
+  if (offset + size > capacity_) {
+    position += capacity_ - offset;
+  }
+  if (position + size - header()->tail.load(std::memory_order_acquire) > capacity_) {
+    return std::nullopt;
+  }
+
+  auto* destination = data() + (position % capacity_);
+  for (const auto& part : parts) {
+    std::memcpy(destination, part.data(), part.size());
+    destination += part.size();
+  }
+  head_ = position + size;
+  header()->head.store(head_, std::memory_order_release);
+  return position;
+}
+
+auto SharedMemoryRing::read(std::uint64_t position, std::size_t size) const -> std::span<const std::byte> {
+  const auto head = header()->head.load(std::memory_order_acquire);
+  const auto tail = header()->tail.load(std::memory_order_relaxed);
+  // Written as differences, the values come from the producer and might overflow otherwise.
+  if (position < tail || position > head || size > head - position ||
+      size > capacity_ - (position % capacity_)) {
+    throw std::system_error(
+        EINVAL, std::system_category(),
+        fmt::format("Invalid shared memory message of {} bytes at {}, ring holds [{}, {})", size, position,
+                    tail, head));
+  }
+  return { data() + (position % capacity_), size };
+}
+
+void SharedMemoryRing::release(std::uint64_t position, std::size_t size) {
+  header()->tail.store(position + size, std::memory_order_release);
+}
+
+auto SharedMemoryRing::header() const -> Header* {
+  return static_cast<Header*>(mapping_);
+}
+
+auto SharedMemoryRing::data() const -> std::byte* {
+  return static_cast<std::byte*>(mapping_) + sizeof(Header);
+}
+}  // namespace heph::net
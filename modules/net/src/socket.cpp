@@ -37,6 +37,8 @@ auto familyToEndpointType(int domain) {
     case AF_BLUETOOTH:
       return heph::net::EndpointType::BT;
 #endif
+    case AF_UNIX:
+      return heph::net::EndpointType::IPC;
     default:
       heph::panic("Unknown domain {}", domain);
   }
@@ -65,6 +67,8 @@ Socket::Socket(concurrency::Context* context, int fd, SocketType type, bool set_
     default:
       break;
   }
+
+  registered_index_ = context_->ring()->registerFile(fd_);
 }
 
 auto Socket::createTcpIpV4(concurrency::Context& context) -> Socket {
@@ -86,6 +90,10 @@ auto Socket::createL2cap(concurrency::Context& context) -> Socket {
 }
 #endif
 
+auto Socket::createUnix(concurrency::Context& context) -> Socket {
+  return Socket{ &context, socket(AF_UNIX, SOCK_STREAM, 0), SocketType::UNIX };
+}
+
 Socket::~Socket() noexcept {
   close();
 }
@@ -95,8 +103,10 @@ Socket::Socket(Socket&& other) noexcept
   , maximum_recv_size_(other.maximum_recv_size_)
   , maximum_send_size_(other.maximum_send_size_)
   , fd_(other.fd_)
+  , registered_index_(other.registered_index_)
   , type_(other.type_) {
   other.fd_ = -1;
+  other.registered_index_ = -1;
 }
 
 auto Socket::operator=(Socket&& other) noexcept -> Socket& {
@@ -105,13 +115,19 @@ auto Socket::operator=(Socket&& other) noexcept -> Socket& {
   maximum_recv_size_ = other.maximum_recv_size_;
   maximum_send_size_ = other.maximum_send_size_;
   fd_ = other.fd_;
+  registered_index_ = other.registered_index_;
   type_ = other.type_;
   other.fd_ = -1;
+  other.registered_index_ = -1;
 
   return *this;
 }
 
 void Socket::close() noexcept {
+  if (registered_index_ != -1) {
+    context_->ring()->unregisterFile(registered_index_);
+    registered_index_ = -1;
+  }
   if (fd_ != -1) {
     ::shutdown(fd_, SHUT_RDWR);
     ::close(fd_);
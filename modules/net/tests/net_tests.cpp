@@ -2,11 +2,18 @@
 // Copyright (C) 2023-2025 HEPHAESTUS Contributors
 //=================================================================================================
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <numeric>
+#include <optional>
 #include <span>
+#include <string>
 #include <system_error>
+#include <thread>
 #include <vector>
 
 #include <exec/async_scope.hpp>
@@ -22,6 +29,7 @@
 #include "hephaestus/net/endpoint.h"
 #include "hephaestus/net/recv.h"
 #include "hephaestus/net/send.h"
+#include "hephaestus/net/shared_memory_ring.h"
 #include "hephaestus/net/socket.h"
 #include "hephaestus/test_utils/heph_test.h"
 
@@ -126,6 +134,90 @@ TEST_F(Net, BtEndpoint) {
   EXPECT_THROW(Endpoint::createBt(":"), error_handling::PanicException);
 }
 
+TEST_F(Net, IpcEndpoint) {
+  const auto ep1(Endpoint::createIpc("heph_net_tests"));
+  const auto ep2(Endpoint::createIpc("heph_net_tests"));
+  const auto ep3(Endpoint::createIpc());
+
+  EXPECT_EQ(ep1, ep2);
+  EXPECT_NE(ep1, ep3);
+  EXPECT_EQ(ep1.type(), EndpointType::IPC);
+  EXPECT_EQ(ep1.address(), "heph_net_tests");
+  EXPECT_EQ(ep1.port(), 0);
+  EXPECT_EQ(fmt::format("{}", ep1), "ipc:heph_net_tests");
+
+  EXPECT_THROW(Endpoint::createIpc(std::string(128, 'a')), error_handling::PanicException);
+}
+
+TEST_F(Net, IpcOperations) {
+  exec::async_scope scope;
+  heph::concurrency::Context context{ {} };
+  const auto acceptor = Acceptor::createUnix(context);
+
+  acceptor.bind(Endpoint::createIpc());
+  acceptor.listen();
+
+  auto endpoint = acceptor.localEndpoint();
+  EXPECT_EQ(endpoint.type(), EndpointType::IPC);
+  EXPECT_FALSE(endpoint.address().empty());
+
+  std::array<char, 4> recv_buffer{};
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto server = [&]() -> exec::task<void> {
+    auto client = co_await accept(acceptor);
+    EXPECT_EQ(client.type(), SocketType::UNIX);
+    co_await recvAll(client, std::as_writable_bytes(std::span{ recv_buffer }));
+    context.requestStop();
+  };
+  scope.spawn(server());
+
+  const auto client{ Socket::createUnix(context) };
+  client.connect(endpoint);
+
+  const std::array<char, 4> send_buffer{ 'h', 'e', 'p', 'h' };
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto client_sender = [&]() -> exec::task<void> {
+    co_await sendAll(client, std::as_bytes(std::span{ send_buffer }));
+  };
+  scope.spawn(client_sender());
+
+  context.run();
+  EXPECT_EQ(recv_buffer, send_buffer);
+}
+
+TEST_F(Net, SharedMemoryRing) {
+  static constexpr std::size_t CAPACITY = 64;
+  static constexpr std::size_t MSG_SIZE = 40;
+  auto producer = SharedMemoryRing::create(CAPACITY);
+  auto consumer = SharedMemoryRing::attach(producer.name());
+  EXPECT_EQ(consumer.capacity(), CAPACITY);
+
+  std::vector<char> message(MSG_SIZE);
+  std::iota(message.begin(), message.end(), 0);  // NOLINT(modernize-use-ranges)
+  const auto payload = std::as_bytes(std::span{ message });
+
+  const auto first = producer.tryWrite(payload);
+  ASSERT_TRUE(first.has_value());
+  // The ring is occupied until the consumer releases the first message.
+  EXPECT_FALSE(producer.tryWrite(payload).has_value());
+
+  const auto received = consumer.read(*first, payload.size());
+  EXPECT_TRUE(std::ranges::equal(received, payload));
+  consumer.release(*first, payload.size());
+
+  // The second message doesn't fit before the end and starts over at the beginning.
+  const auto second = producer.tryWrite(payload);
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(*second, CAPACITY);
+  EXPECT_TRUE(std::ranges::equal(consumer.read(*second, payload.size()), payload));
+
+  EXPECT_THROW((void)consumer.read(*second + 1, payload.size()), std::system_error);
+  EXPECT_THROW((void)consumer.read(*second, std::numeric_limits<std::size_t>::max()), std::system_error);
+  // The name is gone once attached.
+  EXPECT_THROW((void)SharedMemoryRing::attach(producer.name()), std::system_error);
+}
+
 TEST_F(Net, TCPOperationsSome) {
   exec::async_scope scope;
   heph::concurrency::Context context{ {} };
@@ -223,6 +315,108 @@ TEST_F(Net, TCPOperationsAll) {
   EXPECT_EQ(recv_buffer, send_buffer);
 }
 
+TEST_F(Net, TCPOperationsVectored) {
+  exec::async_scope scope;
+  heph::concurrency::Context context{ {} };
+  const auto acceptor = Acceptor::createTcpIpV4(context);
+
+  acceptor.bind(Endpoint::createIpV4());
+  acceptor.listen();
+
+  auto endpoint = acceptor.localEndpoint();
+
+  static constexpr std::size_t HEADER_SIZE = 8;
+  static constexpr std::size_t MSG_SIZE = 4ull * 1024 * 1024;
+  std::vector<char> recv_header(HEADER_SIZE);
+  std::vector<char> recv_buffer(MSG_SIZE);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto server_sender = [&]() -> exec::task<void> {
+    auto client = co_await accept(acceptor);
+    auto header = std::as_writable_bytes(std::span{ recv_header });
+    auto buffer = std::as_writable_bytes(std::span{ recv_buffer });
+
+    while (!buffer.empty()) {
+      auto received = co_await recvMsg(client, std::array{ header, buffer });
+      const auto header_received = std::min(received, header.size());
+      header = header.subspan(header_received);
+      buffer = buffer.subspan(received - header_received);
+    }
+    context.requestStop();
+  };
+
+  scope.spawn(server_sender());
+
+  const auto client{ Socket::createTcpIpV4(context) };
+  client.connect(endpoint);
+
+  std::vector<char> send_header(HEADER_SIZE, 1);
+  std::vector<char> send_buffer(MSG_SIZE);
+  std::iota(send_buffer.begin(), send_buffer.end(), 0);  // NOLINT(modernize-use-ranges)
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto client_sender = [&]() -> exec::task<void> {
+    const auto buffers = std::array{ std::as_bytes(std::span{ send_header }),
+                                     std::as_bytes(std::span{ send_buffer }) };
+    auto sent = co_await sendMsgAll(client, buffers);
+    EXPECT_EQ(sent, HEADER_SIZE + MSG_SIZE);
+  };
+  scope.spawn(client_sender());
+
+  context.run();
+  EXPECT_EQ(recv_header, send_header);
+  EXPECT_EQ(recv_buffer, send_buffer);
+}
+
+TEST_F(Net, RegisteredSocketFromOtherContext) {
+  const concurrency::ContextConfig config{ .io_ring_config = { .registered_files = 4 } };
+  exec::async_scope scope;
+  heph::concurrency::Context context{ config };
+  heph::concurrency::Context other{ config };
+
+  const auto server{ Socket::createUdpIpV4(context) };
+  server.bind(Endpoint::createIpV4("127.0.0.1"));
+
+  std::atomic_flag started = ATOMIC_FLAG_INIT;
+  std::thread context_thread{ [&] {
+    context.run([&started] {
+      started.test_and_set();
+      started.notify_all();
+    });
+  } };
+  started.wait(false);
+
+  // Both rings registered their file descriptor once running, the socket of `context` is created and
+  // registered on the thread running `other`.
+  std::optional<Socket> client;
+  std::thread other_thread{ [&] {
+    other.run([&] {
+      client.emplace(Socket::createUdpIpV4(context));
+      other.requestStop();
+    });
+  } };
+  other_thread.join();
+  ASSERT_TRUE(client.has_value());
+  EXPECT_NE(client->registeredIndex(), -1);
+  client->connect(server.localEndpoint());
+
+  const std::array<char, 4> send_buffer{ 'h', 'e', 'p', 'h' };
+  std::array<char, 4> recv_buffer{};
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto receive = [&]() -> exec::task<void> {
+    co_await recv(server, std::as_writable_bytes(std::span{ recv_buffer }));
+    context.requestStop();
+  };
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-capturing-lambda-coroutines)
+  auto send_message = [&]() -> exec::task<void> {
+    co_await send(*client, std::as_bytes(std::span{ send_buffer }));
+  };
+  scope.spawn(stdexec::starts_on(context.scheduler(), receive()));
+  scope.spawn(stdexec::starts_on(context.scheduler(), send_message()));
+
+  context_thread.join();
+  EXPECT_EQ(recv_buffer, send_buffer);
+}
+
 TEST_F(Net, UDPOperations) {
   exec::async_scope scope;
   heph::concurrency::Context context{ {} };
@@ -25,6 +25,9 @@ namespace heph::serdes::protobuf {
 template <class T>
 [[nodiscard]] auto serialize(const T& data) -> std::vector<std::byte>;
 
+template <class T>
+void serializeAppend(const T& data, std::vector<std::byte>& buffer);
+
 template <class T>
 [[nodiscard]] auto serializeToJSON(const T& data) -> std::string;
 
@@ -53,6 +56,11 @@ auto serialize(const T& data) -> std::vector<std::byte> {
   return internal::serialize<T, typename ProtoAssociation<T>::Type>(data);
 }
 
+template <class T>
+void serializeAppend(const T& data, std::vector<std::byte>& buffer) {
+  internal::serializeAppend<T, typename ProtoAssociation<T>::Type>(data, buffer);
+}
+
 template <class T>
 [[nodiscard]] auto serializeToJSON(const T& data) -> std::string {
   using Proto = ProtoAssociation<T>::Type;
@@ -34,6 +34,15 @@ template <class T, class ProtoT>
   return std::move(buffer).extractSerializedData();
 }
 
+template <class T, class ProtoT>
+void serializeAppend(const T& data, std::vector<std::byte>& buffer) {
+  ProtoT proto;
+  toProto(proto, data);
+  const auto offset = buffer.size();
+  buffer.resize(offset + proto.ByteSizeLong());
+  proto.SerializeToArray(buffer.data() + offset, static_cast<int>(buffer.size() - offset));
+}
+
 template <class T>
 void fromProtobuf(DeserializerBuffer& buffer, T& data) {
   using Proto = ProtoAssociation<T>::Type;
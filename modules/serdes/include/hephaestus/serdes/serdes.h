@@ -35,6 +35,19 @@ template <typename T>
   __builtin_unreachable();
 }
 
+/// Appends the serialized `data` to `buffer`, which lets callers reuse a buffer or place several
+/// messages in one.
+template <typename T>
+void serializeAppend(const T& data, std::vector<std::byte>& buffer) {
+  if constexpr (protobuf::ProtobufSerializable<T>) {
+    protobuf::serializeAppend(data, buffer);
+  } else {
+    static_assert(NOT_SERIALIZABLE<T>,
+                  "serialize is not implemented for this type, did you forget to include the header "
+                  "with the serialization implementation?");
+  }
+}
+
 template <typename T>
 [[nodiscard]] auto serializeToText(const T& data) -> std::string {
   if constexpr (protobuf::ProtobufSerializable<T>) {
@@ -15,12 +15,18 @@ public:
     std::string module;
   };
   explicit Scope(std::string robot_name, std::string module);
+  /// Activates a context owned by the caller without copying it, hence without allocating.
+  /// The context needs to outlive the scope.
+  explicit Scope(const Context& context);
   ~Scope();
 
   Scope(const Scope&) = delete;
   auto operator=(const Scope&) -> Scope& = delete;
   Scope(Scope&&) = delete;
   auto operator=(Scope&&) -> Scope& = delete;
+
+private:
+  Context context_;
 };
 
 [[nodiscard]] auto getCurrentContext() -> const Scope::Context*;
@@ -12,12 +12,18 @@ namespace heph::telemetry {
 namespace {
 // thread_local ensures that each thread gets its own instance of module_stack.
 // This is crucial for correctness in multi-threaded applications.
-thread_local std::vector<Scope::Context>
+// The stack only refers to the contexts, which are owned by the scopes or their callers.
+thread_local std::vector<const Scope::Context*>
     modules_stack;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 }  // namespace
 
-Scope::Scope(std::string robot_name, std::string module) {
-  modules_stack.emplace_back(std::move(robot_name), std::move(module));
+Scope::Scope(std::string robot_name, std::string module)
+  : context_{ .robot_name = std::move(robot_name), .module = std::move(module) } {
+  modules_stack.push_back(&context_);
+}
+
+Scope::Scope(const Context& context) {
+  modules_stack.push_back(&context);
 }
 
 Scope::~Scope() {
@@ -25,7 +31,7 @@ Scope::~Scope() {
 }
 
 auto getCurrentContext() -> const Scope::Context* {
-  return modules_stack.empty() ? nullptr : &modules_stack.back();
+  return modules_stack.empty() ? nullptr : modules_stack.back();
 }
 
 }  // namespace heph::telemetry
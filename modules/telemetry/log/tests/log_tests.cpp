@@ -222,6 +222,13 @@ TEST_F(LogTestFixture, LogWithScope) {
     EXPECT_THAT(sink_ref.getLog(), testing::HasSubstr("module=/robot1/module2"));
   }
 
+  {
+    const Scope::Context context{ .robot_name = "robot2", .module = "module3" };
+    const Scope scope3(context);
+    heph::log(heph::INFO, "a message in a borrowed scope");
+    EXPECT_THAT(sink_ref.getLog(), testing::HasSubstr("module=/robot2/module3"));
+  }
+
   heph::log(heph::INFO, "another message in module1 scope");
   EXPECT_THAT(sink_ref.getLog(), testing::HasSubstr("module=/robot1/module1"));
 }
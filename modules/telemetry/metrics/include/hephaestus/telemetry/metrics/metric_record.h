@@ -19,6 +19,10 @@ namespace heph::telemetry {
 /// There is no limit on the number of sinks supported.
 void registerMetricSink(std::unique_ptr<IMetricSink> sink);
 
+/// @brief Returns true once at least one metric sink has been registered.
+/// Allows hot paths to skip building metrics which nobody would consume.
+[[nodiscard]] auto hasMetricSinks() -> bool;
+
 /// @brief Record a metric.
 /// The metric is forwarded to all registered sinks.
 /// Sinks process the metric in a dedicated thread, this means that this function is non-blocking and
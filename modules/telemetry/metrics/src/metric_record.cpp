@@ -3,6 +3,7 @@
 //=================================================================================================
 #include "hephaestus/telemetry/metrics/metric_record.h"
 
+#include <atomic>
 #include <exception>
 #include <future>
 #include <memory>
@@ -20,6 +21,9 @@
 #include "hephaestus/utils/unique_function.h"
 
 namespace heph::telemetry {
+namespace {
+std::atomic<bool> has_sinks{ false };  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
 
 class MetricRecorder {
 public:
@@ -55,6 +59,10 @@ void registerMetricSink(std::unique_ptr<IMetricSink> sink) {
   MetricRecorder::registerSink(std::move(sink));
 }
 
+auto hasMetricSinks() -> bool {
+  return has_sinks.load(std::memory_order_acquire);
+}
+
 void record(UniqueFunction<Metric()>&& metric) {
   MetricRecorder::record(std::move(metric));
 }
@@ -98,6 +106,7 @@ void MetricRecorder::registerSink(std::unique_ptr<IMetricSink> sink) {
   auto& telemetry = instance();
   const absl::MutexLock lock{ &telemetry.sink_mutex_ };
   telemetry.sinks_.push_back(std::move(sink));
+  has_sinks.store(true, std::memory_order_release);
 }
 
 void MetricRecorder::record(UniqueFunction<Metric()>&& metric) {
@@ -148,6 +148,8 @@ TEST_F(MetricTest, Serialization) {
   static constexpr auto COMPONENT = "component";
   static constexpr auto TAG = "tag";
 
+  EXPECT_TRUE(hasMetricSinks());
+
   auto dummy = Dummy::random(mt);
   record(COMPONENT, TAG, dummy);
 